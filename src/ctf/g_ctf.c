@@ -726,7 +726,7 @@ void CTFDeadDropFlag(edict_t *self)
 
     if (dropped) {
         dropped->think = CTFDropFlagThink;
-        dropped->nextthink = level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT;
+        G_SetNextThink(dropped, level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT);
         dropped->touch = CTFDropFlagTouch;
     }
 }
@@ -743,7 +743,7 @@ void THINK(CTFFlagThink)(edict_t *ent)
 {
     if (ent->solid != SOLID_NOT)
         ent->s.frame = 173 + (((ent->s.frame - 173) + 1) % 16);
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 void THINK(CTFFlagSetup)(edict_t *ent)
@@ -777,7 +777,7 @@ void THINK(CTFFlagSetup)(edict_t *ent)
 
     gi.linkentity(ent);
 
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     ent->think = CTFFlagThink;
 }
 
@@ -1697,7 +1697,7 @@ void THINK(TechThink)(edict_t *tech)
         SpawnTech(tech->item, spot);
         G_FreeEdict(tech);
     } else {
-        tech->nextthink = level.time + CTF_TECH_TIMEOUT;
+        G_SetNextThink(tech, level.time + CTF_TECH_TIMEOUT);
         tech->think = TechThink;
     }
 }
@@ -1707,7 +1707,7 @@ void CTFDrop_Tech(edict_t *ent, const gitem_t *item)
     edict_t *tech;
 
     tech = Drop_Item(ent, item);
-    tech->nextthink = level.time + CTF_TECH_TIMEOUT;
+    G_SetNextThink(tech, level.time + CTF_TECH_TIMEOUT);
     tech->think = TechThink;
     ent->client->pers.inventory[item->id] = 0;
 }
@@ -1722,7 +1722,7 @@ void CTFDeadDropTech(edict_t *ent)
             // hack the velocity to make it bounce random
             dropped->velocity[0] = crandom_open() * 300;
             dropped->velocity[1] = crandom_open() * 300;
-            dropped->nextthink = level.time + CTF_TECH_TIMEOUT;
+            G_SetNextThink(dropped, level.time + CTF_TECH_TIMEOUT);
             dropped->think = TechThink;
             dropped->owner = NULL;
             ent->client->pers.inventory[tech_ids[i]] = 0;
@@ -1761,7 +1761,7 @@ static void SpawnTech(const gitem_t *item, edict_t *spot)
     VectorScale(forward, 100, ent->velocity);
     ent->velocity[2] = 300;
 
-    ent->nextthink = level.time + CTF_TECH_TIMEOUT;
+    G_SetNextThink(ent, level.time + CTF_TECH_TIMEOUT);
     ent->think = TechThink;
 
     gi.linkentity(ent);
@@ -1804,7 +1804,7 @@ void CTFSetupTechSpawn(void)
         return;
 
     ent = G_Spawn();
-    ent->nextthink = level.time + SEC(2);
+    G_SetNextThink(ent, level.time + SEC(2));
     ent->think = SpawnTechs;
 }
 
@@ -1958,7 +1958,7 @@ The banner is 248 tall.
 void THINK(misc_ctf_banner_think)(edict_t *ent)
 {
     ent->s.frame = (ent->s.frame + 1) % 16;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 #define SPAWNFLAG_CTF_BANNER_BLUE   1
@@ -1975,7 +1975,7 @@ void SP_misc_ctf_banner(edict_t *ent)
     gi.linkentity(ent);
 
     ent->think = misc_ctf_banner_think;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 /*QUAKED misc_ctf_small_banner (1 .5 0) (-4 -32 0) (4 32 124) TEAM2
@@ -1994,7 +1994,7 @@ void SP_misc_ctf_small_banner(edict_t *ent)
     gi.linkentity(ent);
 
     ent->think = misc_ctf_banner_think;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 /*-----------------------------------------------------------------------*/
@@ -2100,7 +2100,7 @@ static void CTFResetAllPlayers(void)
         if (ent->inuse && !ent->client) {
             if (ent->solid == SOLID_NOT && ent->think == DoRespawn &&
                 ent->nextthink >= level.time) {
-                ent->nextthink = 0;
+                G_SetNextThink(ent, 0);
                 DoRespawn(ent);
             }
         }
@@ -496,10 +496,10 @@ static void Cmd_AlertAll_f(edict_t *ent)
     if (!G_CheatCheck(ent))
         return;
 
-    for (int i = game.maxclients + BODY_QUEUE_SIZE + 1; i < globals.num_edicts; i++) {
-        edict_t *t = &g_edicts[i];
+    edict_t *t;
 
-        if (!t->inuse || t->health <= 0 || !(t->svflags & SVF_MONSTER))
+    for (int i = 0; (t = G_NextActiveEdict(&i)); ) {
+        if (t->health <= 0 || !(t->svflags & SVF_MONSTER))
             continue;
 
         t->enemy = ent;
@@ -913,6 +913,7 @@ static void Cmd_Kill_AI_f(edict_t * ent)
 
     // except the one we're looking at...
     edict_t *looked_at = NULL;
+    edict_t *edict;
     vec3_t start, end;
 
     VectorCopy(ent->s.origin, start);
@@ -922,9 +923,8 @@ static void Cmd_Kill_AI_f(edict_t * ent)
 
     looked_at = gi.trace(start, NULL, NULL, end, ent, MASK_SHOT).ent;
 
-    for (int i = game.maxclients + BODY_QUEUE_SIZE + 1; i < globals.num_edicts; i++) {
-        edict_t *edict = &g_edicts[i];
-        if (!edict->inuse || edict == looked_at)
+    for (int i = 0; (edict = G_NextActiveEdict(&i)); ) {
+        if (edict == looked_at)
             continue;
         if (!(edict->svflags & SVF_MONSTER))
             continue;
@@ -956,10 +956,9 @@ static void Cmd_Clear_AI_Enemy_f(edict_t *ent)
         return;
     }
 
-    for (int i = game.maxclients + BODY_QUEUE_SIZE + 1; i < globals.num_edicts; i++) {
-        edict_t *edict = &g_edicts[i];
-        if (!edict->inuse)
-            continue;
+    edict_t *edict;
+
+    for (int i = 0; (edict = G_NextActiveEdict(&i)); ) {
         if (!(edict->svflags & SVF_MONSTER))
             continue;
         edict->monsterinfo.aiflags |= AI_FORGET_ENEMY;
@@ -465,6 +465,9 @@ void T_Damage(edict_t *targ, edict_t *inflictor, edict_t *attacker, const vec3_t
     if (!targ->takedamage)
         return;
 
+    // pain and die callbacks may change movetype
+    G_WakeEntity(targ);
+
     if (g_instagib->integer && attacker->client && targ->client)
         // [Kex] always kill no matter what on instagib
         damage = 9999;
@@ -95,7 +95,7 @@ void THINK(Move_Final)(edict_t *ent)
     VectorScale(dir, 1.0f / FRAME_TIME_SEC, ent->velocity);
 
     ent->think = Move_Done;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
 }
 
 void THINK(Move_Begin)(edict_t *ent)
@@ -109,7 +109,7 @@ void THINK(Move_Begin)(edict_t *ent)
     VectorScale(ent->moveinfo.dir, ent->moveinfo.speed, ent->velocity);
     frames = floorf((ent->moveinfo.remaining_distance / ent->moveinfo.speed) / FRAME_TIME_SEC);
     ent->moveinfo.remaining_distance -= frames * ent->moveinfo.speed * FRAME_TIME_SEC;
-    ent->nextthink = level.time + (FRAME_TIME * frames);
+    G_SetNextThink(ent, level.time + (FRAME_TIME * frames));
     ent->think = Move_Final;
 }
 
@@ -127,14 +127,14 @@ void Move_Calc(edict_t *ent, const vec3_t dest, void (*endfunc)(edict_t *self))
         if (level.current_entity == ((ent->flags & FL_TEAMSLAVE) ? ent->teammaster : ent)) {
             Move_Begin(ent);
         } else {
-            ent->nextthink = level.time + FRAME_TIME;
+            G_SetNextThink(ent, level.time + FRAME_TIME);
             ent->think = Move_Begin;
         }
     } else {
         // accelerative
         ent->moveinfo.current_speed = 0;
         ent->think = Think_AccelMove;
-        ent->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(ent, level.time + FRAME_TIME);
     }
 }
 
@@ -172,7 +172,7 @@ void THINK(AngleMove_Final)(edict_t *ent)
     VectorScale(move, 1.0f / FRAME_TIME_SEC, ent->avelocity);
 
     ent->think = AngleMove_Done;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
 }
 
 void THINK(AngleMove_Begin)(edict_t *ent)
@@ -214,10 +214,10 @@ void THINK(AngleMove_Begin)(edict_t *ent)
     //  if we're done accelerating, act as a normal rotation
     if (ent->moveinfo.speed >= ent->speed) {
         // set nextthink to trigger a think when dest is reached
-        ent->nextthink = level.time + (FRAME_TIME * frames);
+        G_SetNextThink(ent, level.time + (FRAME_TIME * frames));
         ent->think = AngleMove_Final;
     } else {
-        ent->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(ent, level.time + FRAME_TIME);
         ent->think = AngleMove_Begin;
     }
     // PGM
@@ -237,7 +237,7 @@ static void AngleMove_Calc(edict_t *ent, void (*endfunc)(edict_t *self))
     if (level.current_entity == ((ent->flags & FL_TEAMSLAVE) ? ent->teammaster : ent)) {
         AngleMove_Begin(ent);
     } else {
-        ent->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(ent, level.time + FRAME_TIME);
         ent->think = AngleMove_Begin;
     }
 }
@@ -374,7 +374,7 @@ void THINK(Think_AccelMove)(edict_t *ent)
     }
 
     VectorScale(ent->moveinfo.dir, ent->moveinfo.current_speed * 10, ent->velocity);
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     ent->think = Think_AccelMove;
 }
 
@@ -389,7 +389,7 @@ void MOVEINFO_ENDFUNC(plat_hit_top)(edict_t *ent)
     ent->moveinfo.state = STATE_TOP;
 
     ent->think = plat_go_down;
-    ent->nextthink = level.time + SEC(3);
+    G_SetNextThink(ent, level.time + SEC(3));
 }
 
 void MOVEINFO_ENDFUNC(plat_hit_bottom)(edict_t *ent)
@@ -495,7 +495,7 @@ void TOUCH(Touch_Plat_Center)(edict_t *ent, edict_t *other, const trace_t *tr, b
     if (ent->moveinfo.state == STATE_BOTTOM)
         plat_go_up(ent);
     else if (ent->moveinfo.state == STATE_TOP)
-        ent->nextthink = level.time + SEC(1); // the player is still on the plat, so delay going down
+        G_SetNextThink(ent, level.time + SEC(1)); // the player is still on the plat, so delay going down
 }
 
 // PGM - plat2's change the trigger field
@@ -666,7 +666,7 @@ void THINK(rotating_accel)(edict_t *self)
         current_speed += self->accel;
         VectorScale(self->movedir, current_speed, self->avelocity);
         self->think = rotating_accel;
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     }
 }
 
@@ -682,7 +682,7 @@ void THINK(rotating_decel)(edict_t *self)
         current_speed -= self->decel;
         VectorScale(self->movedir, current_speed, self->avelocity);
         self->think = rotating_decel;
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     }
 }
 // PGM
@@ -824,7 +824,7 @@ void THINK(func_spinning_think)(edict_t *ent)
             ent->avelocity[i] = max(ent->movedir[i], ent->avelocity[i] - ent->accel);
     }
 
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
 }
 
 // [Paril-KEX]
@@ -840,7 +840,7 @@ void SP_func_spinning(edict_t *ent)
     ent->movetype = MOVETYPE_PUSH;
 
     ent->timestamp = 0;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     ent->think = func_spinning_think;
 
     gi.setmodel(ent, ent->model);
@@ -911,7 +911,7 @@ void MOVEINFO_ENDFUNC(button_wait)(edict_t *self)
     G_UseTargets(self, self->activator);
 
     if (self->moveinfo.wait >= 0) {
-        self->nextthink = level.time + SEC(self->moveinfo.wait);
+        G_SetNextThink(self, level.time + SEC(self->moveinfo.wait));
         self->think = button_return;
     }
 }
@@ -1051,7 +1051,7 @@ static void door_use_areaportals(edict_t *self, bool open)
     if (!self->target)
         return;
 
-    while ((t = G_Find(t, FOFS(targetname), self->target))) {
+    while ((t = G_FindByTargetname(t, self->target))) {
         if (Q_strcasecmp(t->classname, "func_areaportal") == 0) {
             gi.SetAreaPortalState(t->style, open);
         }
@@ -1104,7 +1104,7 @@ void MOVEINFO_ENDFUNC(door_hit_top)(edict_t *self)
 
     if (self->moveinfo.wait >= 0) {
         self->think = door_go_down;
-        self->nextthink = level.time + SEC(self->moveinfo.wait);
+        G_SetNextThink(self, level.time + SEC(self->moveinfo.wait));
     }
 
     if (self->spawnflags & SPAWNFLAG_DOOR_START_OPEN)
@@ -1155,7 +1155,7 @@ static void door_go_up(edict_t *self, edict_t *activator)
     if (self->moveinfo.state == STATE_TOP) {
         // reset top wait time
         if (self->moveinfo.wait >= 0)
-            self->nextthink = level.time + SEC(self->moveinfo.wait);
+            G_SetNextThink(self, level.time + SEC(self->moveinfo.wait));
         return;
     }
 
@@ -1191,13 +1191,13 @@ void THINK(smart_water_go_up)(edict_t *self)
     if (self->moveinfo.state == STATE_TOP) {
         // reset top wait time
         if (self->moveinfo.wait >= 0)
-            self->nextthink = level.time + SEC(self->moveinfo.wait);
+            G_SetNextThink(self, level.time + SEC(self->moveinfo.wait));
         return;
     }
 
     if (self->health && self->absmax[2] >= self->health) {
         VectorClear(self->velocity);
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
         self->moveinfo.state = STATE_TOP;
         return;
     }
@@ -1249,7 +1249,7 @@ void THINK(smart_water_go_up)(edict_t *self)
     }
 
     self->think = smart_water_go_up;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 // PGM
 //======
@@ -1557,7 +1557,7 @@ void SP_func_door(edict_t *ent)
 
     gi.linkentity(ent);
 
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
 
     if (ent->spawnflags & SPAWNFLAG_DOOR_START_OPEN)
         ent->think = Think_DoorActivateAreaPortal;
@@ -1582,7 +1582,7 @@ void USE(Door_Activate)(edict_t *self, edict_t *other, edict_t *activator)
         self->think = Think_CalcMoveSpeed;
     else
         self->think = Think_SpawnDoorTrigger;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 // PGM
 
@@ -1730,7 +1730,7 @@ void SP_func_door_rotating(edict_t *ent)
 
     gi.linkentity(ent);
 
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     if (ent->health || ent->targetname)
         ent->think = Think_CalcMoveSpeed;
     else
@@ -1741,7 +1741,7 @@ void SP_func_door_rotating(edict_t *ent)
         ent->takedamage = false;
         ent->die = NULL;
         ent->think = NULL;
-        ent->nextthink = 0;
+        G_SetNextThink(ent, 0);
         ent->use = Door_Activate;
     }
     // PGM
@@ -1907,7 +1907,7 @@ void MOVEINFO_ENDFUNC(train_wait)(edict_t *self)
 
     if (self->moveinfo.wait) {
         if (self->moveinfo.wait > 0) {
-            self->nextthink = level.time + SEC(self->moveinfo.wait);
+            G_SetNextThink(self, level.time + SEC(self->moveinfo.wait));
             self->think = train_next;
         } else if (self->spawnflags & SPAWNFLAG_TRAIN_TOGGLE) { // && wait < 0
             // PMM - clear target_ent, let train_next get called when we get used
@@ -1916,7 +1916,7 @@ void MOVEINFO_ENDFUNC(train_wait)(edict_t *self)
             // pmm
             self->spawnflags &= ~SPAWNFLAG_TRAIN_START_ON;
             VectorClear(self->velocity);
-            self->nextthink = 0;
+            G_SetNextThink(self, 0);
         }
 
         if (!(self->flags & FL_TEAMSLAVE) && self->moveinfo.sound_end)
@@ -2116,7 +2116,7 @@ void THINK(func_train_find)(edict_t *self)
         self->spawnflags |= SPAWNFLAG_TRAIN_START_ON;
 
     if (self->spawnflags & SPAWNFLAG_TRAIN_START_ON) {
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
         self->think = train_next;
         self->activator = self;
     }
@@ -2131,7 +2131,7 @@ void USE(train_use)(edict_t *self, edict_t *other, edict_t *activator)
             return;
         self->spawnflags &= ~SPAWNFLAG_TRAIN_START_ON;
         VectorClear(self->velocity);
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
     } else {
         if (self->target_ent)
             train_resume(self);
@@ -2180,7 +2180,7 @@ void SP_func_train(edict_t *self)
     if (self->target) {
         // start trains on the second frame, to make sure their targets have had
         // a chance to spawn
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
         self->think = func_train_find;
     } else {
         gi.dprintf("%s: no target\n", etos(self));
@@ -2234,7 +2234,7 @@ void THINK(trigger_elevator_init)(edict_t *self)
 void SP_trigger_elevator(edict_t *self)
 {
     self->think = trigger_elevator_init;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 /*QUAKED func_timer (0.3 0.1 0.6) (-8 -8 -8) (8 8 8) START_ON
@@ -2257,7 +2257,7 @@ These can used but not touched.
 void THINK(func_timer_think)(edict_t *self)
 {
     G_UseTargets(self, self->activator);
-    self->nextthink = level.time + SEC(self->wait + crandom() * self->random);
+    G_SetNextThink(self, level.time + SEC(self->wait + crandom() * self->random));
 }
 
 void USE(func_timer_use)(edict_t *self, edict_t *other, edict_t *activator)
@@ -2266,13 +2266,13 @@ void USE(func_timer_use)(edict_t *self, edict_t *other, edict_t *activator)
 
     // if on, turn it off
     if (self->nextthink) {
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
         return;
     }
 
     // turn it on
     if (self->delay)
-        self->nextthink = level.time + SEC(self->delay);
+        G_SetNextThink(self, level.time + SEC(self->delay));
     else
         func_timer_think(self);
 }
@@ -2291,7 +2291,7 @@ void SP_func_timer(edict_t *self)
     }
 
     if (self->spawnflags & SPAWNFLAG_TIMER_START_ON) {
-        self->nextthink = level.time + SEC(1 + st.pausetime + self->delay + self->wait + crandom() * self->random);
+        G_SetNextThink(self, level.time + SEC(1 + st.pausetime + self->delay + self->wait + crandom() * self->random));
         self->activator = self;
     }
 
@@ -2375,7 +2375,7 @@ void USE(door_secret_use)(edict_t *self, edict_t *other, edict_t *activator)
 
 void MOVEINFO_ENDFUNC(door_secret_move1)(edict_t *self)
 {
-    self->nextthink = level.time + SEC(1);
+    G_SetNextThink(self, level.time + SEC(1));
     self->think = door_secret_move2;
 }
 
@@ -2388,7 +2388,7 @@ void MOVEINFO_ENDFUNC(door_secret_move3)(edict_t *self)
 {
     if (self->wait == -1)
         return;
-    self->nextthink = level.time + SEC(self->wait);
+    G_SetNextThink(self, level.time + SEC(self->wait));
     self->think = door_secret_move4;
 }
 
@@ -2399,7 +2399,7 @@ void THINK(door_secret_move4)(edict_t *self)
 
 void MOVEINFO_ENDFUNC(door_secret_move5)(edict_t *self)
 {
-    self->nextthink = level.time + SEC(1);
+    G_SetNextThink(self, level.time + SEC(1));
     self->think = door_secret_move6;
 }
 
@@ -2637,7 +2637,7 @@ void THINK(func_eye_think)(edict_t *self)
         self->s.angles[i] = anglemod(current + move);
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void THINK(func_eye_setup)(edict_t *self)
@@ -2652,7 +2652,7 @@ void THINK(func_eye_setup)(edict_t *self)
     VectorNormalize2(self->move_origin, self->movedir);
 
     self->think = func_eye_think;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void SP_func_eye(edict_t *ent)
@@ -2683,10 +2683,10 @@ void SP_func_eye(edict_t *ent)
 
     if (ent->pathtarget) {
         ent->think = func_eye_setup;
-        ent->nextthink = level.time + HZ(10);
+        G_SetNextThink(ent, level.time + HZ(10));
     } else {
         ent->think = func_eye_think;
-        ent->nextthink = level.time + HZ(10);
+        G_SetNextThink(ent, level.time + HZ(10));
 
         vec3_t right, up;
         AngleVectors(ent->move_angles, ent->movedir, right, up);
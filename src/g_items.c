@@ -74,6 +74,11 @@ const gitem_t *GetItemByPowerup(powerup_t powerup)
     return poweruplist[powerup];
 }
 
+static uint16_t    classname_slots[256];
+static uint16_t    use_name_slots[256];
+static name_hash_t classname_hash;
+static name_hash_t use_name_hash;
+
 /*
 ===============
 FindItemByClassname
@@ -82,18 +87,9 @@ FindItemByClassname
 */
 const gitem_t *FindItemByClassname(const char *classname)
 {
-    int            i;
-    const gitem_t *it;
-
-    it = itemlist;
-    for (i = 0; i < IT_TOTAL; i++, it++) {
-        if (!it->classname)
-            continue;
-        if (!Q_strcasecmp(it->classname, classname))
-            return it;
-    }
+    int i = G_FindName(&classname_hash, classname);
 
-    return NULL;
+    return i == -1 ? NULL : &itemlist[i];
 }
 
 /*
@@ -104,18 +100,9 @@ FindItem
 */
 const gitem_t *FindItem(const char *pickup_name)
 {
-    int            i;
-    const gitem_t *it;
-
-    it = itemlist;
-    for (i = 0; i < IT_TOTAL; i++, it++) {
-        if (!it->use_name)
-            continue;
-        if (!Q_strcasecmp(it->use_name, pickup_name))
-            return it;
-    }
+    int i = G_FindName(&use_name_hash, pickup_name);
 
-    return NULL;
+    return i == -1 ? NULL : &itemlist[i];
 }
 
 //======================================================================
@@ -189,7 +176,7 @@ void SetRespawnEx(edict_t *ent, gtime_t delay, bool hide_self)
         gi.linkentity(ent);
     }
 
-    ent->nextthink = level.time + delay;
+    G_SetNextThink(ent, level.time + delay);
     ent->think = DoRespawn;
 }
 
@@ -622,7 +609,7 @@ void THINK(MegaHealth_think)(edict_t *self)
         //ZOID
        )
     {
-        self->nextthink = level.time + SEC(1);
+        G_SetNextThink(self, level.time + SEC(1));
         self->owner->health -= 1;
         return;
     }
@@ -669,7 +656,7 @@ static bool Pickup_Health(edict_t *ent, edict_t *other)
             other->client->pers.megahealth_time = SEC(5);
         } else {
             ent->think = MegaHealth_think;
-            ent->nextthink = level.time + SEC(5);
+            G_SetNextThink(ent, level.time + SEC(5));
             ent->owner = other;
             ent->flags |= FL_RESPAWN;
             ent->svflags |= SVF_NOCLIENT;
@@ -966,7 +953,7 @@ void THINK(drop_make_touchable)(edict_t *ent)
 {
     ent->touch = Touch_Item;
     if (deathmatch->integer) {
-        ent->nextthink = level.time + SEC(29);
+        G_SetNextThink(ent, level.time + SEC(29));
         ent->think = G_FreeEdict;
     }
 }
@@ -1009,7 +996,7 @@ edict_t *Drop_Item(edict_t *ent, const gitem_t *item)
     dropped->velocity[2] = 300;
 
     dropped->think = drop_make_touchable;
-    dropped->nextthink = level.time + SEC(1);
+    G_SetNextThink(dropped, level.time + SEC(1));
 
     if (coop->integer && P_UseCoopInstancedItems())
         dropped->svflags |= SVF_INSTANCED;
@@ -1098,7 +1085,7 @@ void THINK(droptofloor)(edict_t *ent)
         ent->solid = SOLID_NOT;
 
         if (ent == ent->teammaster) {
-            ent->nextthink = level.time + HZ(10);
+            G_SetNextThink(ent, level.time + HZ(10));
             ent->think = DoRespawn;
         }
     }
@@ -1340,7 +1327,7 @@ void SpawnItem(edict_t *ent, const gitem_t *item)
         ent->svflags |= SVF_INSTANCED;
 
     ent->item = item;
-    ent->nextthink = level.time + HZ(5); // items start after other solids
+    G_SetNextThink(ent, level.time + HZ(5)); // items start after other solids
     ent->think = droptofloor;
     if (!(level.is_spawning && ED_WasKeySpecified("effects")) && !ent->s.effects)
         ent->s.effects = item->world_model_flags;
@@ -3136,6 +3123,12 @@ void InitItems(void)
         else if ((item->flags & IF_POWERUP_WHEEL) && !(item->flags & IF_WEAPON) && item->tag >= POWERUP_SCREEN && item->tag < POWERUP_MAX)
             poweruplist[item->tag] = item;
     }
+
+    // name lookups
+    G_InitNameHash(&classname_hash, classname_slots, q_countof(classname_slots), itemlist,
+                   sizeof(gitem_t), q_offsetof(gitem_t, classname), IT_TOTAL);
+    G_InitNameHash(&use_name_hash, use_name_slots, q_countof(use_name_slots), itemlist,
+                   sizeof(gitem_t), q_offsetof(gitem_t, use_name), IT_TOTAL);
 }
 
 /*
@@ -110,6 +110,8 @@ enum {
     TAG_LEVEL,      // clear when loading a new level
     TAG_L10N,       // localization strings
     TAG_NAV,        // bot navigation data
+    TAG_SAVE,       // savegame buffers, freed after save/load
+    TAG_BASELINE,   // spawn baseline of the level for delta savegames
 };
 
 #define MELEE_DISTANCE  50
@@ -1210,6 +1212,9 @@ extern cvar_t *g_skipViewModifiers;
 extern cvar_t *sv_stopspeed; // PGM - this was a define in g_phys.c
 
 extern cvar_t *g_strict_saves;
+extern cvar_t *g_binary_saves;
+extern cvar_t *g_async_saves;
+extern cvar_t *g_delta_saves;
 extern cvar_t *g_coop_health_scaling;
 extern cvar_t *g_weapon_respawn_time;
 
@@ -1330,6 +1335,27 @@ void closest_point_to_box(const vec3_t from, const vec3_t mins, const vec3_t max
 float distance_between_boxes(const vec3_t mins1, const vec3_t maxs1, const vec3_t mins2, const vec3_t maxs2);
 bool boxes_intersect(const vec3_t mins1, const vec3_t maxs1, const vec3_t mins2, const vec3_t maxs2);
 edict_t *G_Find(edict_t *from, int fieldofs, const char *match);
+void     G_LinkTargetname(edict_t *ent);
+void     G_UnlinkTargetname(edict_t *ent);
+edict_t *G_FindByTargetname(edict_t *from, const char *match);
+
+typedef struct {
+    const byte  *base;
+    size_t      stride;
+    size_t      name_ofs;
+    uint16_t    *slots;     // element index + 1, 0 if empty
+    unsigned    mask;
+} name_hash_t;
+
+void     G_InitNameHash(name_hash_t *hash, uint16_t *slots, int num_slots,
+                        const void *base, size_t stride, size_t name_ofs, int count);
+int      G_FindName(const name_hash_t *hash, const char *name);
+
+void     G_GridLinkEntity(edict_t *ent);
+void     G_GridUnlinkEntity(edict_t *ent);
+void     G_BoxCandidates(const vec3_t mins, const vec3_t maxs, byte *bits);
+const byte *G_RadiusCandidates(const vec3_t org, float rad);
+int      G_NextCandidate(const byte *bits, int num);
 edict_t *findradius(edict_t *from, const vec3_t org, float rad);
 edict_t *G_PickTarget(const char *targetname);
 void     G_UseTargets(edict_t *ent, edict_t *activator);
@@ -1339,6 +1365,11 @@ float    vectoyaw(const vec3_t vec);
 void     vectoangles(const vec3_t value1, vec3_t angles);
 char    *etos(edict_t *ent);
 
+void     G_CompactEdictList(void);
+void     G_InitEdictLists(void);
+edict_t *G_NextActiveEdict(int *iter);
+void     G_RegisterTrap(edict_t *ent);
+edict_t *G_NextTrap(int *iter);
 void     G_InitEdict(edict_t *e);
 edict_t *G_Spawn(void);
 void     G_FreeEdict(edict_t *e);
@@ -1370,6 +1401,7 @@ char *ED_NewString(const char *string);
 bool ED_WasKeySpecified(const char *key);
 void ED_SetKeySpecified(const char *key);
 void ED_InitSpawnVars(void);
+void ED_InitSpawnHashes(void);
 const char *G_GetLightStyle(int style);
 void G_AddPrecache(void (*func)(void));
 void G_RefreshPrecaches(void);
@@ -1385,6 +1417,9 @@ void WriteLevel(const char *filename);
 void ReadLevel(const char *filename);
 void G_CleanupSaves(void);
 qboolean G_CanSave(void);
+void G_InitSaveFields(void);
+bool G_BeginBaseline(const char *mapname);
+void G_EndBaseline(void);
 
 //
 // g_target.c
@@ -1730,6 +1765,18 @@ void player_die(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage
 void ServerCommand(void);
 bool SV_FilterPacket(const char *from);
 
+//
+// g_threads.c
+//
+typedef void (*job_func_t)(void *arg, int index, int worker);
+
+void G_InitThreads(void);
+void G_ShutdownThreads(void);
+int G_NumWorkers(void);
+void G_RunJobs(job_func_t func, void *arg, int count);
+void G_RunBackground(job_func_t func, void *arg);
+void G_WaitBackground(void);
+
 //
 // p_view.c
 //
@@ -1810,6 +1857,12 @@ contents_t G_GetClipMask(edict_t *ent);
 void G_Impact(edict_t *e1, const trace_t *trace);
 void ClipVelocity(const vec3_t in, const vec3_t normal, vec3_t out, float overbounce);
 void SlideClipVelocity(const vec3_t in, const vec3_t normal, vec3_t out, float overbounce);
+void G_ClearThinkQueue(void);
+void G_WakeEntity(edict_t *ent);
+void G_SetNextThink(edict_t *ent, gtime_t nextthink);
+void G_CheckSleep(edict_t *ent);
+void G_RunThinkQueue(void);
+int G_NextAwakeEntity(int num);
 
 //
 // g_main.c
@@ -2421,7 +2474,7 @@ struct edict_s {
     float    yaw_speed;
     float    ideal_yaw;
 
-    gtime_t nextthink;
+    gtime_t nextthink; // only write through G_SetNextThink
     void (*prethink)(edict_t *self);
     void (*postthink)(edict_t *self);
     void (*think)(edict_t *self);
@@ -73,6 +73,9 @@ cvar_t *flood_waitdelay;
 cvar_t *sv_stopspeed; // PGM     (this was a define in g_phys.c)
 
 cvar_t *g_strict_saves;
+cvar_t *g_binary_saves;
+cvar_t *g_async_saves;
+cvar_t *g_delta_saves;
 
 // ROGUE cvars
 cvar_t *gamerules;
@@ -286,6 +289,9 @@ static void InitGame(void)
     flood_waitdelay = gi.cvar("flood_waitdelay", "10", 0);
 
     g_strict_saves = gi.cvar("g_strict_saves", "1", 0);
+    g_binary_saves = gi.cvar("g_binary_saves", "0", 0);
+    g_async_saves = gi.cvar("g_async_saves", "0", 0);
+    g_delta_saves = gi.cvar("g_delta_saves", "0", 0);
 
     sv_airaccelerate = gi.cvar("sv_airaccelerate", "0", 0);
 
@@ -333,6 +339,10 @@ static void InitGame(void)
     // items
     InitItems();
 
+    // field name lookups for spawning and loading
+    ED_InitSpawnHashes();
+    G_InitSaveFields();
+
     // initialize all entities for this game
     game.maxentities = Q_clip(maxentities->integer, maxclients->integer + 1, MAX_EDICTS);
     g_edicts = gi.TagMalloc(game.maxentities * sizeof(g_edicts[0]), TAG_GAME);
@@ -369,6 +379,7 @@ static void InitGame(void)
 
     G_LoadL10nFile();
 
+    G_InitThreads();
     Nav_Init();
 
     cv = gi.cvar("game", NULL, 0);
@@ -383,10 +394,12 @@ static void ShutdownGame(void)
 
     memset(&game, 0, sizeof(game));
 
+    gi.FreeTags(TAG_BASELINE);
     gi.FreeTags(TAG_LEVEL);
     gi.FreeTags(TAG_GAME);
 
     Nav_Shutdown();
+    G_ShutdownThreads();
     G_FreeL10nFile();
     G_CleanupSaves();
 }
@@ -404,6 +417,19 @@ static void G_RestartFilesystem(void)
     Nav_Load(level.mapname);
 }
 
+static void (*SV_LinkEntity)(edict_t *ent);
+
+// entity could have been moved or had its movetype changed by someone
+// else, make sure it gets a chance to run physics and update its position
+// in the spatial grid and its effect on nav nodes
+static void G_LinkEntity(edict_t *ent)
+{
+    SV_LinkEntity(ent);
+    G_GridLinkEntity(ent);
+    Nav_EntityLinked(ent);
+    G_WakeEntity(ent);
+}
+
 /*
 =================
 GetGameAPI
@@ -416,6 +442,9 @@ q_exported game_export_t *GetGameAPI(game_import_t *import)
 {
     gi = *import;
 
+    SV_LinkEntity = gi.linkentity;
+    gi.linkentity = G_LinkEntity;
+
     globals.apiversion = GAME_API_VERSION;
     globals.Init = InitGame;
     globals.Shutdown = ShutdownGame;
@@ -852,9 +881,13 @@ static void G_RunFrame_(bool main_loop)
     //
     // treat each object in turn
     // even the world gets a chance to think
+    // sleeping entities are skipped until their think is due
     //
-    ent = &g_edicts[0];
-    for (int i = 0; i < globals.num_edicts; i++, ent++) {
+    G_RunThinkQueue();
+
+    for (int i = 0; (i = G_NextAwakeEntity(i)) < globals.num_edicts; i++) {
+        ent = &g_edicts[i];
+
         if (!ent->inuse) {
             // defer removing client info so that disconnected, etc works
             if (i > 0 && i <= game.maxclients) {
@@ -864,6 +897,7 @@ static void G_RunFrame_(bool main_loop)
                     ent->timestamp = 0;
                 }
             }
+            G_CheckSleep(ent);
             continue;
         }
 
@@ -899,6 +933,7 @@ static void G_RunFrame_(bool main_loop)
         }
 
         G_RunEntity(ent);
+        G_CheckSleep(ent);
     }
 
     // see if it is time to end a deathmatch
@@ -983,8 +1018,16 @@ player processing happens outside RunFrame
 */
 static void G_PrepFrame(void)
 {
-    for (int i = 0; i < globals.num_edicts; i++)
+    int num_fixed = min(globals.num_edicts, game.maxclients + BODY_QUEUE_SIZE + 1);
+    edict_t *ent;
+
+    G_CompactEdictList();
+
+    for (int i = 0; i < num_fixed; i++)
         g_edicts[i].s.event = EV_NONE;
+
+    for (int i = 0; (ent = G_NextActiveEdict(&i)); )
+        ent->s.event = EV_NONE;
 }
 
 #ifndef GAME_HARD_LINKED
@@ -173,9 +173,9 @@ edict_t *ThrowGibEx(edict_t *self, const char *gibname, int damage, gib_type_t t
     gib->think = G_FreeEdict;
 
     if (g_instagib->integer)
-        gib->nextthink = level.time + random_time_sec(1, 5);
+        G_SetNextThink(gib, level.time + random_time_sec(1, 5));
     else
-        gib->nextthink = level.time + random_time_sec(10, 20);
+        G_SetNextThink(gib, level.time + random_time_sec(10, 20));
 
     gi.linkentity(gib);
 
@@ -227,7 +227,7 @@ void ThrowClientHead(edict_t *self, int damage)
         self->client->anim_end = self->s.frame;
     } else {
         self->think = NULL;
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
     }
 
     gi.linkentity(self);
@@ -683,7 +683,7 @@ void SP_func_object(edict_t *self)
         self->solid = SOLID_BSP;
         self->movetype = MOVETYPE_PUSH;
         self->think = func_object_release;
-        self->nextthink = level.time + HZ(5);
+        G_SetNextThink(self, level.time + HZ(5));
     } else {
         self->solid = SOLID_NOT;
         self->movetype = MOVETYPE_PUSH;
@@ -931,7 +931,7 @@ void THINK(barrel_burn)(edict_t *self)
 
     self->x.morefx |= EFX_BARREL_EXPLODING;
     self->s.sound = gi.soundindex("weapons/bfg__l1a.wav");
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void DIE(barrel_delay)(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage, const vec3_t point, mod_t mod)
@@ -957,7 +957,7 @@ void THINK(barrel_think)(edict_t *self)
 {
     // the think needs to be first since later stuff may override.
     self->think = barrel_think;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     M_CategorizePosition(self, self->s.origin, &self->waterlevel, &self->watertype);
     self->flags |= FL_IMMUNE_SLIME;
@@ -969,7 +969,7 @@ void THINK(barrel_start)(edict_t *self)
 {
     M_droptofloor(self);
     self->think = barrel_think;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 // PGM
 //=========
@@ -1005,6 +1005,7 @@ void SP_misc_explobox(edict_t *self)
     self->die = barrel_delay;
     self->takedamage = true;
     self->flags |= FL_TRAP;
+    G_RegisterTrap(self);
 
     if (self->spawnflags & SPAWNFLAG_EXPLOBOX_NO_MOVE)
         self->flags |= FL_NO_KNOCKBACK;
@@ -1013,7 +1014,7 @@ void SP_misc_explobox(edict_t *self)
 
     // PGM - change so barrels will think and hence, blow up
     self->think = barrel_start;
-    self->nextthink = level.time + HZ(5);
+    G_SetNextThink(self, level.time + HZ(5));
     // PGM
 
     gi.linkentity(self);
@@ -1053,7 +1054,7 @@ void THINK(misc_blackhole_think)(edict_t *self)
         self->s.angles[1] += 50.0f * FRAME_TIME_SEC;
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void SP_misc_blackhole(edict_t *ent)
@@ -1066,7 +1067,7 @@ void SP_misc_blackhole(edict_t *ent)
     ent->s.renderfx = RF_TRANSLUCENT | RF_NOSHADOW;
     ent->use = misc_blackhole_use;
     ent->think = misc_blackhole_think;
-    ent->nextthink = level.time + HZ(5);
+    G_SetNextThink(ent, level.time + HZ(5));
 
     if (ent->spawnflags & SPAWNFLAG_BLACKHOLE_AUTO_NOISE) {
         ent->s.sound = gi.soundindex("world/blackhole.wav");
@@ -1082,10 +1083,10 @@ void SP_misc_blackhole(edict_t *ent)
 void THINK(misc_eastertank_think)(edict_t *self)
 {
     if (++self->s.frame < 293)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     else {
         self->s.frame = 254;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     }
 }
 
@@ -1098,7 +1099,7 @@ void SP_misc_eastertank(edict_t *ent)
     ent->s.modelindex = gi.modelindex("models/monsters/tank/tris.md2");
     ent->s.frame = 254;
     ent->think = misc_eastertank_think;
-    ent->nextthink = level.time + HZ(5);
+    G_SetNextThink(ent, level.time + HZ(5));
     gi.linkentity(ent);
 }
 
@@ -1108,10 +1109,10 @@ void SP_misc_eastertank(edict_t *ent)
 void THINK(misc_easterchick_think)(edict_t *self)
 {
     if (++self->s.frame < 247)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     else {
         self->s.frame = 208;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     }
 }
 
@@ -1124,7 +1125,7 @@ void SP_misc_easterchick(edict_t *ent)
     ent->s.modelindex = gi.modelindex("models/monsters/bitch/tris.md2");
     ent->s.frame = 208;
     ent->think = misc_easterchick_think;
-    ent->nextthink = level.time + HZ(5);
+    G_SetNextThink(ent, level.time + HZ(5));
     gi.linkentity(ent);
 }
 
@@ -1134,10 +1135,10 @@ void SP_misc_easterchick(edict_t *ent)
 void THINK(misc_easterchick2_think)(edict_t *self)
 {
     if (++self->s.frame < 287)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     else {
         self->s.frame = 248;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     }
 }
 
@@ -1150,7 +1151,7 @@ void SP_misc_easterchick2(edict_t *ent)
     ent->s.modelindex = gi.modelindex("models/monsters/bitch/tris.md2");
     ent->s.frame = 248;
     ent->think = misc_easterchick2_think;
-    ent->nextthink = level.time + HZ(5);
+    G_SetNextThink(ent, level.time + HZ(5));
     gi.linkentity(ent);
 }
 
@@ -1162,9 +1163,9 @@ There should be a item_commander_head that has this as it's target.
 void THINK(commander_body_think)(edict_t *self)
 {
     if (++self->s.frame < 24)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     else
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
 
     if (self->s.frame == 22)
         gi.sound(self, CHAN_BODY, gi.soundindex("tank/thud.wav"), 1, ATTN_NORM, 0);
@@ -1173,7 +1174,7 @@ void THINK(commander_body_think)(edict_t *self)
 void USE(commander_body_use)(edict_t *self, edict_t *other, edict_t *activator)
 {
     self->think = commander_body_think;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
     gi.sound(self, CHAN_BODY, gi.soundindex("tank/pain.wav"), 1, ATTN_NORM, 0);
 }
 
@@ -1200,7 +1201,7 @@ void SP_monster_commander_body(edict_t *self)
     gi.soundindex("tank/pain.wav");
 
     self->think = commander_body_drop;
-    self->nextthink = level.time + HZ(2);
+    G_SetNextThink(self, level.time + HZ(2));
 }
 
 /*QUAKED misc_banner (1 .5 0) (-4 -4 -4) (4 4 4)
@@ -1211,7 +1212,7 @@ model="models/objects/banner/tris.md2"
 void THINK(misc_banner_think)(edict_t *ent)
 {
     ent->s.frame = (ent->s.frame + 1) % 16;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 void SP_misc_banner(edict_t *ent)
@@ -1224,7 +1225,7 @@ void SP_misc_banner(edict_t *ent)
     gi.linkentity(ent);
 
     ent->think = misc_banner_think;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 /*QUAKED misc_deadsoldier (1 .5 0) (-16 -16 0) (16 16 16) ON_BACK ON_STOMACH BACK_DECAP FETAL_POS SIT_DECAP IMPALED
@@ -1326,7 +1327,7 @@ void SP_misc_viper(edict_t *ent)
     VectorSet(ent->maxs, 16, 16, 32);
 
     ent->think = func_train_find;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     ent->use = misc_viper_use;
     ent->svflags |= SVF_NOCLIENT;
     ent->moveinfo.accel = ent->moveinfo.decel = ent->moveinfo.speed = ent->speed;
@@ -1447,7 +1448,7 @@ void SP_misc_strogg_ship(edict_t *ent)
     VectorSet(ent->maxs, 16, 16, 32);
 
     ent->think = func_train_find;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     ent->use = misc_strogg_ship_use;
     ent->svflags |= SVF_NOCLIENT;
     ent->moveinfo.accel = ent->moveinfo.decel = ent->moveinfo.speed = ent->speed;
@@ -1462,14 +1463,14 @@ void THINK(misc_satellite_dish_think)(edict_t *self)
 {
     self->s.frame++;
     if (self->s.frame < 38)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
 }
 
 void USE(misc_satellite_dish_use)(edict_t *self, edict_t *other, edict_t *activator)
 {
     self->s.frame = 0;
     self->think = misc_satellite_dish_think;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void SP_misc_satellite_dish(edict_t *ent)
@@ -1519,7 +1520,7 @@ void SP_misc_gib_arm(edict_t *ent)
     ent->deadflag = true;
     frandom_vec(ent->avelocity, 200);
     ent->think = G_FreeEdict;
-    ent->nextthink = level.time + SEC(10);
+    G_SetNextThink(ent, level.time + SEC(10));
     gi.linkentity(ent);
 }
 
@@ -1537,7 +1538,7 @@ void SP_misc_gib_leg(edict_t *ent)
     ent->deadflag = true;
     frandom_vec(ent->avelocity, 200);
     ent->think = G_FreeEdict;
-    ent->nextthink = level.time + SEC(10);
+    G_SetNextThink(ent, level.time + SEC(10));
     gi.linkentity(ent);
 }
 
@@ -1555,7 +1556,7 @@ void SP_misc_gib_head(edict_t *ent)
     ent->deadflag = true;
     frandom_vec(ent->avelocity, 200);
     ent->think = G_FreeEdict;
-    ent->nextthink = level.time + SEC(10);
+    G_SetNextThink(ent, level.time + SEC(10));
     gi.linkentity(ent);
 }
 
@@ -1667,7 +1668,7 @@ static void func_clock_format_countdown(edict_t *self)
 void THINK(func_clock_think)(edict_t *self)
 {
     if (!self->enemy) {
-        self->enemy = G_Find(NULL, FOFS(targetname), self->target);
+        self->enemy = G_FindByTargetname(NULL, self->target);
         if (!self->enemy)
             return;
     }
@@ -1692,6 +1693,7 @@ void THINK(func_clock_think)(edict_t *self)
     }
 
     self->enemy->message = self->clock_message;
+    G_WakeEntity(self->enemy);
     self->enemy->use(self->enemy, self, self);
 
     if (((self->spawnflags & SPAWNFLAG_TIMER_UP) && (self->health > self->wait)) ||
@@ -1714,7 +1716,7 @@ void THINK(func_clock_think)(edict_t *self)
             return;
     }
 
-    self->nextthink = level.time + SEC(1);
+    G_SetNextThink(self, level.time + SEC(1));
 }
 
 void USE(func_clock_use)(edict_t *self, edict_t *other, edict_t *activator)
@@ -1751,7 +1753,7 @@ void SP_func_clock(edict_t *self)
     if (self->spawnflags & SPAWNFLAG_TIMER_START_OFF)
         self->use = func_clock_use;
     else
-        self->nextthink = level.time + SEC(1);
+        G_SetNextThink(self, level.time + SEC(1));
 }
 
 //=================================================================================
@@ -1766,7 +1768,7 @@ void TOUCH(teleporter_touch)(edict_t *self, edict_t *other, const trace_t *tr, b
     if (!other->client)
         return;
 
-    dest = G_Find(NULL, FOFS(targetname), self->target);
+    dest = G_FindByTargetname(NULL, self->target);
     if (!dest) {
         gi.dprintf("Couldn't find destination\n");
         return;
@@ -1932,7 +1934,7 @@ void SP_misc_flare(edict_t *ent)
 void THINK(misc_hologram_think)(edict_t *ent)
 {
     ent->s.angles[1] += 100 * FRAME_TIME_SEC;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     ent->x.alpha = frandom2(0.2f, 0.6f);
 }
 
@@ -1947,7 +1949,7 @@ void SP_misc_hologram(edict_t *ent)
     VectorSet(ent->maxs, 16, 16, 32);
     ent->x.morefx = EFX_HOLOGRAM;
     ent->think = misc_hologram_think;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     ent->x.alpha = frandom2(0.2f, 0.6f);
     ent->x.scale = 0.75f;
     gi.linkentity(ent);
@@ -1992,18 +1994,18 @@ void THINK(fire_fly)(edict_t *self)
     fireball->classname = "fireball";
     gi.setmodel(fireball, "models/objects/gibs/sm_meat/tris.md2");
     VectorCopy(self->s.origin, fireball->s.origin);
-    fireball->nextthink = level.time + SEC(5);
+    G_SetNextThink(fireball, level.time + SEC(5));
     fireball->think = G_FreeEdict;
     fireball->touch = fire_touch;
     fireball->spawnflags = self->spawnflags;
     gi.linkentity(fireball);
-    self->nextthink = level.time + random_time_sec(0, 5);
+    G_SetNextThink(self, level.time + random_time_sec(0, 5));
 }
 
 void SP_misc_lavaball(edict_t *self)
 {
     self->classname = "fireball";
-    self->nextthink = level.time + random_time_sec(0, 5);
+    G_SetNextThink(self, level.time + random_time_sec(0, 5));
     self->think = fire_fly;
     if (!self->speed)
         self->speed = 185;
@@ -2025,7 +2027,7 @@ void USE(info_world_text_use)(edict_t *self, edict_t *other, edict_t *activator)
         self->activator = activator;
         self->think(self);
     } else {
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
         self->activator = NULL;
     }
 
@@ -2034,8 +2036,10 @@ void USE(info_world_text_use)(edict_t *self, edict_t *other, edict_t *activator)
 
     if (self->target) {
         edict_t *target = G_PickTarget(self->target);
-        if (target && target->use && target != self)
+        if (target && target->use && target != self) {
+            G_WakeEntity(target);
             target->use(target, self, self);
+        }
     }
 
     if (self->spawnflags & SPAWNFLAG_WORLD_TEXT_REMOVE_ON_TRIGGER)
@@ -2065,7 +2069,7 @@ void THINK(info_world_text_think)(edict_t *self)
         textAngle[YAW] = anglemod(self->s.angles[YAW] + 180);
         draw->AddDebugText(self->s.origin, textAngle, self->message, self->size[2], colors[self->sounds], FRAME_TIME, true);
     }
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 /*QUAKED info_world_text (1.0 1.0 0.0) (-16 -16 0) (16 16 32)
@@ -2085,7 +2089,7 @@ void SP_info_world_text(edict_t *self)
     self->size[2] *= 16;
 
     if (!(self->spawnflags & SPAWNFLAG_WORLD_TEXT_START_OFF)) {
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
         self->activator = self;
     }
 }
@@ -2151,7 +2155,7 @@ void THINK(misc_player_mannequin_think)(edict_t *self)
         M_ChangeYaw(self);
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 static void SetupMannequinModel(edict_t *self, int model_type, const char *weapon, const char *skin)
@@ -2230,7 +2234,7 @@ void SP_misc_player_mannequin(edict_t *self)
     VectorScale(self->maxs, self->x.scale, self->maxs);
 
     self->think = misc_player_mannequin_think;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     if (self->targetname)
         self->use = misc_player_mannequin_use;
@@ -2267,7 +2271,7 @@ void USE(info_nav_lock_use)(edict_t *self, edict_t *other, edict_t *activator)
 {
     edict_t *n = NULL;
 
-    while ((n = G_Find(n, FOFS(targetname), self->target))) {
+    while ((n = G_FindByTargetname(n, self->target))) {
         if (!(n->svflags & SVF_DOOR)) {
             gi.dprintf("%s tried targeting %s, a non-SVF_DOOR\n", etos(self), etos(n));
             continue;
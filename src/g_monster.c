@@ -469,7 +469,7 @@ static void M_MoveFrame(edict_t *self)
     // 10hz, but will run aifuncs at full speed with
     // distance spread over 10hz
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     // time to run next 10hz move yet?
     bool run_frame = self->monsterinfo.next_move_time <= level.time;
@@ -689,13 +689,13 @@ void THINK(monster_dead_think)(edict_t *self)
             self->s.frame++;
     }
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void monster_dead(edict_t *self)
 {
     self->think = monster_dead_think;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
     self->movetype = MOVETYPE_TOSS;
     self->svflags |= SVF_DEADMONSTER;
     self->monsterinfo.damage_blood = 0;
@@ -871,7 +871,7 @@ void USE(monster_triggered_spawn_use)(edict_t *self, edict_t *other, edict_t *ac
 {
     // we have a one frame delay here so we don't telefrag the guy who activated us
     self->think = monster_triggered_spawn;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     if (activator && activator->client && !(self->hackflags & HACKFLAG_END_CUTSCENE))
         self->enemy = activator;
     self->use = monster_use;
@@ -879,7 +879,7 @@ void USE(monster_triggered_spawn_use)(edict_t *self, edict_t *other, edict_t *ac
     if (self->spawnflags & SPAWNFLAG_MONSTER_SCENIC) {
         M_droptofloor(self);
 
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
         self->think(self);
 
         if (self->spawnflags & SPAWNFLAG_MONSTER_AMBUSH)
@@ -903,17 +903,16 @@ static void monster_triggered_start(edict_t *self)
         FOFS(combattarget),
     };
 
+    edict_t *ent;
+
     self->solid = SOLID_NOT;
     self->movetype = MOVETYPE_NONE;
     self->svflags |= SVF_NOCLIENT;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     self->use = monster_triggered_spawn_use;
 
     if (self->targetname)
-        for (int i = game.maxclients + BODY_QUEUE_SIZE + 1; i < globals.num_edicts; i++) {
-            edict_t *ent = &g_edicts[i];
-            if (!ent->inuse)
-                continue;
+        for (int i = 0; (ent = G_NextActiveEdict(&i)); ) {
             for (int j = 0; j < q_countof(offsets); j++) {
                 char *s = *(char **)((byte *)ent + offsets[j]);
                 if (!s)
@@ -990,9 +989,10 @@ static void G_Monster_ScaleCoopHealth(edict_t *self)
 // check all active monsters' scaling
 void G_Monster_CheckCoopHealthScaling(void)
 {
-    for (int i = game.maxclients + BODY_QUEUE_SIZE + 1; i < globals.num_edicts; i++) {
-        edict_t *ent = &g_edicts[i];
-        if (ent->inuse && (ent->flags & FL_COOP_HEALTH_SCALE) && ent->health > 0)
+    edict_t *ent;
+
+    for (int i = 0; (ent = G_NextActiveEdict(&i)); ) {
+        if ((ent->flags & FL_COOP_HEALTH_SCALE) && ent->health > 0)
             G_Monster_ScaleCoopHealth(ent);
     }
 }
@@ -1031,7 +1031,7 @@ bool monster_start(edict_t *self)
         level.total_monsters++;
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     self->svflags |= SVF_MONSTER;
     self->takedamage = true;
     self->air_finished = level.time + SEC(12);
@@ -1193,7 +1193,7 @@ void monster_start_go(edict_t *self)
         bool     fixup = false;
         edict_t *target = NULL;
 
-        while ((target = G_Find(target, FOFS(targetname), self->target)) != NULL) {
+        while ((target = G_FindByTargetname(target, self->target)) != NULL) {
             if (strcmp(target->classname, "point_combat") == 0) {
                 self->combattarget = self->target;
                 fixup = true;
@@ -1211,7 +1211,7 @@ void monster_start_go(edict_t *self)
     if (self->combattarget) {
         edict_t *target = NULL;
 
-        while ((target = G_Find(target, FOFS(targetname), self->combattarget)) != NULL)
+        while ((target = G_FindByTargetname(target, self->combattarget)) != NULL)
             if (strcmp(target->classname, "point_combat") != 0)
                 gi.dprintf("%s has a bad combattarget %s (%s)\n", etos(self), self->combattarget, etos(target));
     }
@@ -1293,7 +1293,7 @@ void monster_start_go(edict_t *self)
         self->monsterinfo.aiflags &= ~AI_SPAWNED_DEAD;
     } else {
         self->think = monster_think;
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
         self->monsterinfo.aiflags |= AI_SPAWNED_ALIVE;
     }
 }
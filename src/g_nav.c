@@ -5,7 +5,14 @@
 #include "g_local.h"
 #include "g_nav.h"
 #include "q_files.h"
-#include "q_list.h"
+
+#if (defined __SSE2__) || (defined _M_X64) || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define USE_NAV_SSE2    1
+#elif (defined __ARM_NEON)
+#include <arm_neon.h>
+#define USE_NAV_NEON    1
+#endif
 
 // magic file header
 #define NAV_MAGIC   MakeLittleLong('N', 'A', 'V', '3')
@@ -137,21 +144,32 @@ typedef struct nav_edict_s {
 // a NULL context can be passed to any functions expecting
 // one, which will refer to a built-in context instead.
 typedef struct {
-    const nav_node_t  *node;
-    float             f_score;
-    list_t            entry;
+    float       f_score;
+    uint32_t    seq;
+    int         node;
 } nav_open_t;
 
 typedef struct {
-    // TODO: min-heap or priority queue ordered by f_score?
-    // currently using linked list which is a bit slow for insertion
+    // binary min-heap ordered by f_score, ties broken by
+    // insertion order; each node is in the heap at most once
     nav_open_t  *open_set;
-    list_t      open_set_head, open_set_free;
+    uint32_t    *open_pos;  // heap index + 1, 0 if not in open set
+    uint32_t    num_open;
+    uint32_t    open_seq;
 
     // TODO: figure out a way to get rid of "came_from"
     // and track start -> end off the bat
     uint16_t    *came_from, *went_to;
     float       *g_score;
+
+    // per node scratch state is only valid if node_gen
+    // matches generation, otherwise node is unvisited
+    uint32_t    *node_gen;
+    uint32_t    generation;
+
+    // clusters on coarse path have corridor set to corridor_stamp
+    uint32_t    *corridor;
+    uint32_t    corridor_stamp;
 } nav_ctx_t;
 
 // wrapper for PathRequest that includes our
@@ -161,8 +179,90 @@ typedef struct {
     PathInfo            *info;
     nav_ctx_t           *ctx;
     const nav_node_t    *start, *goal;
+    bool                corridor;   // only expand into clusters in ctx corridor
+    uint32_t            version;    // nav_data.version search was started at
+    int                 num_points; // set by Nav_FinishPath
 } nav_path_t;
 
+// candidate node for closest node search
+typedef struct {
+    float       dist;
+    uint32_t    id;
+} nav_candidate_t;
+
+// cached closest node search result
+typedef struct {
+    vec3_t              pos;
+    gtime_t             time;
+    bool                ignore_flags;
+    PathFlags           path_flags;
+    float               min_height, max_height, radius;
+    const nav_node_t    *node;
+} nav_closest_t;
+
+// edge between clusters, usable if any of its links are
+typedef struct {
+    uint32_t    target;
+    float       cost;
+    uint32_t    first_link, num_links;  // into cluster_links
+} nav_cluster_edge_t;
+
+#define NAV_CLUSTER_CELLS   4       // grid cells per cluster side
+
+// time-sliced path request
+typedef struct {
+    int             owner;
+    int             spawn_count;
+    uint32_t        seq;
+    bool            started, finished;
+    gtime_t         time;
+    PathRequest     request;
+    PathInfo        info;
+    nav_path_t      path;
+} nav_pending_t;
+
+#define NAV_MAX_PENDING     32
+
+// restart pending search if goal moves further than this
+#define NAV_PENDING_GOAL_MOVE   64
+
+// cheapest paths from every node towards a goal node
+typedef struct {
+    int         goal;
+    bool        ignore_flags;
+    PathFlags   path_flags;
+    float       jump_height, drop_height;
+    uint32_t    version;
+    gtime_t     time, used;
+    float       *cost;
+    uint16_t    *next_hop;
+} nav_flow_t;
+
+#define NAV_MAX_FLOWS       8
+#define NAV_FLOW_LIFETIME   SEC(1)
+
+#define NAV_MAX_CACHED_PATHS    32
+#define NAV_MAX_CACHED_POINTS   256
+#define NAV_PATH_LIFETIME       SEC(1)
+
+// search result shared between requests with same start and goal nodes
+typedef struct {
+    bool        valid;
+    int         start, goal;
+    bool        ignore_flags;
+    PathFlags   path_flags;
+    float       jump_height, drop_height;
+    uint32_t    version;
+    gtime_t     time, used;
+    int         num_points;     // -1 if no path found
+    uint16_t    points[NAV_MAX_CACHED_POINTS];
+} nav_cached_path_t;
+
+#define NAV_GRID_CELL       128
+#define NAV_FILTER_WIDTH    4
+#define NAV_GRID_MAX_SIZE   512
+#define NAV_MAX_CLOSEST     16
+
 static struct {
     uint32_t    num_nodes;
     uint32_t    num_links;
@@ -177,15 +277,76 @@ static struct {
 
     uint32_t    num_conditional_nodes;
     nav_node_t  **conditional_nodes;
+    byte        *dirty_nodes;           // per node, needs update this frame
+    uint32_t    next_conditional;       // start of background update slice
 
     // built-in context
     nav_ctx_t   ctx;
     bool        setup_entities;
+
+    // uniform grid over node origins on XY plane,
+    // nodes are sorted by cell then by id
+    vec2_t          grid_origin;
+    float           grid_cell_size;
+    int             grid_width, grid_height;
+    uint32_t        *grid_cells;    // first grid_nodes index, width * height + 1
+    uint16_t        *grid_nodes;
+    nav_candidate_t *candidates;
+
+    // node origins and flags in grid_nodes order, padded with
+    // NAV_FILTER_WIDTH - 1 slots, for filtering several nodes at once
+    float           *slot_x, *slot_y, *slot_z;
+    uint16_t        *slot_flags;
+    uint16_t        *node_slots;    // grid_nodes index of each node
+
+    // nodes partitioned into clusters of nearby grid cells
+    uint32_t            num_clusters;
+    uint32_t            num_cluster_links;
+    uint16_t            *node_clusters;
+    vec3_t              *cluster_origins;
+    uint32_t            *cluster_first_edge;    // num_clusters + 1
+    nav_cluster_edge_t  *cluster_edges;
+    uint16_t            *cluster_links;
+
+    // next_hop[goal * num_nodes + node] over static walk links
+    uint16_t        *next_hop;
+
+    // incoming links of each node, for searching backwards from goal
+    uint16_t        *link_sources;
+    uint32_t        *in_first;  // first in_links index, num_nodes + 1
+    uint16_t        *in_links;
+
+    // bumped whenever node flags change
+    uint32_t        version;
+    nav_flow_t      flows[NAV_MAX_FLOWS];
+
+    nav_cached_path_t   cached_paths[NAV_MAX_CACHED_PATHS];
+    uint32_t            cache_hits, cache_misses;
+
+    // nodes popped from open set by searches
+    uint32_t        nodes_expanded;
+
+    // time-sliced searches
+    nav_ctx_t       async_ctx;
+    nav_pending_t   pending[NAV_MAX_PENDING];
+    uint32_t        pending_seq;
+    int             search_budget;
+
+    // results of closest node searches made this frame
+    nav_closest_t   closest[NAV_MAX_CLOSEST];
+    int             num_closest, next_closest;
 } nav_data;
 
 static cvar_t *nav_enable;
 static cvar_t *nav_debug;
 static cvar_t *nav_debug_range;
+static cvar_t *nav_search_budget;
+static cvar_t *nav_flow_fields;
+static cvar_t *nav_conditional_slice;
+static cvar_t *nav_clusters;
+static cvar_t *nav_cache;
+static cvar_t *nav_hop_table;
+static cvar_t *nav_path_cache;
 
 static void Nav_AllocContext(nav_ctx_t *ctx)
 {
@@ -193,6 +354,665 @@ static void Nav_AllocContext(nav_ctx_t *ctx)
     ctx->came_from = gi.TagMalloc(sizeof(ctx->came_from[0]) * nav_data.num_nodes, TAG_NAV);
     ctx->went_to   = gi.TagMalloc(sizeof(ctx->went_to  [0]) * nav_data.num_nodes, TAG_NAV);
     ctx->open_set  = gi.TagMalloc(sizeof(ctx->open_set [0]) * nav_data.num_nodes, TAG_NAV);
+    ctx->open_pos  = gi.TagMalloc(sizeof(ctx->open_pos [0]) * nav_data.num_nodes, TAG_NAV);
+    ctx->node_gen  = gi.TagMalloc(sizeof(ctx->node_gen [0]) * nav_data.num_nodes, TAG_NAV);
+    memset(ctx->node_gen, 0, sizeof(ctx->node_gen[0]) * nav_data.num_nodes);
+    ctx->generation = 0;
+    ctx->corridor  = gi.TagMalloc(sizeof(ctx->corridor [0]) * nav_data.num_nodes, TAG_NAV);
+    memset(ctx->corridor, 0, sizeof(ctx->corridor[0]) * nav_data.num_nodes);
+    ctx->corridor_stamp = 0;
+}
+
+static void Nav_BuildSlots(void)
+{
+    // grid rows start at any slot, so last block may begin at last node
+    uint32_t i, num_slots = nav_data.num_nodes + NAV_FILTER_WIDTH - 1;
+
+    nav_data.slot_x     = gi.TagMalloc(sizeof(nav_data.slot_x    [0]) * num_slots, TAG_NAV);
+    nav_data.slot_y     = gi.TagMalloc(sizeof(nav_data.slot_y    [0]) * num_slots, TAG_NAV);
+    nav_data.slot_z     = gi.TagMalloc(sizeof(nav_data.slot_z    [0]) * num_slots, TAG_NAV);
+    nav_data.slot_flags = gi.TagMalloc(sizeof(nav_data.slot_flags[0]) * num_slots, TAG_NAV);
+    nav_data.node_slots = gi.TagMalloc(sizeof(nav_data.node_slots[0]) * nav_data.num_nodes, TAG_NAV);
+
+    for (i = 0; i < nav_data.num_nodes; i++) {
+        const nav_node_t *node = &nav_data.nodes[nav_data.grid_nodes[i]];
+        nav_data.slot_x[i] = node->origin[0];
+        nav_data.slot_y[i] = node->origin[1];
+        nav_data.slot_z[i] = node->origin[2];
+        nav_data.slot_flags[i] = node->flags;
+        nav_data.node_slots[node->id] = i;
+    }
+
+    // padding never passes the filter
+    for (; i < num_slots; i++) {
+        nav_data.slot_x[i] = nav_data.slot_y[i] = nav_data.slot_z[i] = INFINITY;
+        nav_data.slot_flags[i] = NodeFlag_Disabled;
+    }
+}
+
+static void Nav_FreeContext(nav_ctx_t *ctx)
+{
+    gi.TagFree(ctx->g_score);
+    gi.TagFree(ctx->came_from);
+    gi.TagFree(ctx->went_to);
+    gi.TagFree(ctx->open_set);
+    gi.TagFree(ctx->open_pos);
+    gi.TagFree(ctx->node_gen);
+    gi.TagFree(ctx->corridor);
+}
+
+// allocates per level state that isn't part of cached nav data
+static void Nav_AllocRuntime(void)
+{
+    Nav_AllocContext(&nav_data.ctx);
+    Nav_AllocContext(&nav_data.async_ctx);
+    Nav_BuildSlots();
+
+    nav_data.candidates = gi.TagMalloc(sizeof(nav_data.candidates[0]) * nav_data.num_nodes, TAG_NAV);
+
+    // update all conditional nodes on first frame
+    nav_data.dirty_nodes = gi.TagMalloc(sizeof(nav_data.dirty_nodes[0]) * nav_data.num_nodes, TAG_NAV);
+    memset(nav_data.dirty_nodes, true, sizeof(nav_data.dirty_nodes[0]) * nav_data.num_nodes);
+}
+
+static int Nav_GridCoord(float v, float origin, int size)
+{
+    v = Q_clipf((v - origin) / nav_data.grid_cell_size, -1, size);
+    return Q_clip((int)floorf(v), 0, size - 1);
+}
+
+static void Nav_BuildGrid(void)
+{
+    vec2_t mins = { INFINITY, INFINITY };
+    vec2_t maxs = { -INFINITY, -INFINITY };
+    int i, num_cells;
+
+    for (i = 0; i < nav_data.num_nodes; i++) {
+        const nav_node_t *node = &nav_data.nodes[i];
+        mins[0] = min(mins[0], node->origin[0]);
+        mins[1] = min(mins[1], node->origin[1]);
+        maxs[0] = max(maxs[0], node->origin[0]);
+        maxs[1] = max(maxs[1], node->origin[1]);
+    }
+
+    float extent = max(maxs[0] - mins[0], maxs[1] - mins[1]);
+
+    nav_data.grid_origin[0] = mins[0];
+    nav_data.grid_origin[1] = mins[1];
+    nav_data.grid_cell_size = max(NAV_GRID_CELL, extent / NAV_GRID_MAX_SIZE);
+    nav_data.grid_width = (maxs[0] - mins[0]) / nav_data.grid_cell_size + 1;
+    nav_data.grid_height = (maxs[1] - mins[1]) / nav_data.grid_cell_size + 1;
+    nav_data.grid_width = min(nav_data.grid_width, NAV_GRID_MAX_SIZE);
+    nav_data.grid_height = min(nav_data.grid_height, NAV_GRID_MAX_SIZE);
+
+    num_cells = nav_data.grid_width * nav_data.grid_height;
+    nav_data.grid_cells = gi.TagMalloc(sizeof(nav_data.grid_cells[0]) * (num_cells + 1), TAG_NAV);
+    nav_data.grid_nodes = gi.TagMalloc(sizeof(nav_data.grid_nodes[0]) * nav_data.num_nodes, TAG_NAV);
+    memset(nav_data.grid_cells, 0, sizeof(nav_data.grid_cells[0]) * (num_cells + 1));
+
+    // counting sort nodes into cells
+    for (i = 0; i < nav_data.num_nodes; i++) {
+        const nav_node_t *node = &nav_data.nodes[i];
+        int x = Nav_GridCoord(node->origin[0], nav_data.grid_origin[0], nav_data.grid_width);
+        int y = Nav_GridCoord(node->origin[1], nav_data.grid_origin[1], nav_data.grid_height);
+        nav_data.grid_cells[y * nav_data.grid_width + x + 1]++;
+    }
+
+    for (i = 0; i < num_cells; i++)
+        nav_data.grid_cells[i + 1] += nav_data.grid_cells[i];
+
+    uint32_t *fill = gi.TagMalloc(sizeof(fill[0]) * num_cells, TAG_NAV);
+    memcpy(fill, nav_data.grid_cells, sizeof(fill[0]) * num_cells);
+
+    for (i = 0; i < nav_data.num_nodes; i++) {
+        const nav_node_t *node = &nav_data.nodes[i];
+        int x = Nav_GridCoord(node->origin[0], nav_data.grid_origin[0], nav_data.grid_width);
+        int y = Nav_GridCoord(node->origin[1], nav_data.grid_origin[1], nav_data.grid_height);
+        nav_data.grid_nodes[fill[y * nav_data.grid_width + x]++] = i;
+    }
+
+    gi.TagFree(fill);
+}
+
+static void Nav_BuildIncomingLinks(void)
+{
+    int i, j;
+
+    nav_data.link_sources = gi.TagMalloc(sizeof(nav_data.link_sources[0]) * nav_data.num_links, TAG_NAV);
+    nav_data.in_first = gi.TagMalloc(sizeof(nav_data.in_first[0]) * (nav_data.num_nodes + 1), TAG_NAV);
+    nav_data.in_links = gi.TagMalloc(sizeof(nav_data.in_links[0]) * nav_data.num_links, TAG_NAV);
+    memset(nav_data.in_first, 0, sizeof(nav_data.in_first[0]) * (nav_data.num_nodes + 1));
+
+    for (i = 0; i < nav_data.num_nodes; i++) {
+        const nav_node_t *node = &nav_data.nodes[i];
+        for (j = 0; j < node->num_links; j++) {
+            nav_data.link_sources[node->links - nav_data.links + j] = i;
+            nav_data.in_first[node->links[j].target->id + 1]++;
+        }
+    }
+
+    for (i = 0; i < nav_data.num_nodes; i++)
+        nav_data.in_first[i + 1] += nav_data.in_first[i];
+
+    uint32_t *fill = gi.TagMalloc(sizeof(fill[0]) * nav_data.num_nodes, TAG_NAV);
+    memcpy(fill, nav_data.in_first, sizeof(fill[0]) * nav_data.num_nodes);
+
+    for (i = 0; i < nav_data.num_nodes; i++) {
+        const nav_node_t *node = &nav_data.nodes[i];
+        for (j = 0; j < node->num_links; j++)
+            nav_data.in_links[fill[node->links[j].target->id]++] = node->links - nav_data.links + j;
+    }
+
+    gi.TagFree(fill);
+}
+
+typedef struct {
+    uint32_t    source, target;
+    uint32_t    link;
+} nav_portal_t;
+
+static int Nav_PortalCmp(const void *p1, const void *p2)
+{
+    const nav_portal_t *a = p1;
+    const nav_portal_t *b = p2;
+
+    if (a->source != b->source)
+        return a->source < b->source ? -1 : 1;
+    if (a->target != b->target)
+        return a->target < b->target ? -1 : 1;
+    return a->link < b->link ? -1 : 1;
+}
+
+// must be called after Nav_BuildGrid
+static void Nav_BuildClusters(void)
+{
+    int width = (nav_data.grid_width + NAV_CLUSTER_CELLS - 1) / NAV_CLUSTER_CELLS;
+    int height = (nav_data.grid_height + NAV_CLUSTER_CELLS - 1) / NAV_CLUSTER_CELLS;
+    int i, j, num_portals;
+
+    // number clusters in order of first node
+    int *cells = gi.TagMalloc(sizeof(cells[0]) * width * height, TAG_NAV);
+    memset(cells, -1, sizeof(cells[0]) * width * height);
+
+    nav_data.num_clusters = 0;
+    nav_data.node_clusters = gi.TagMalloc(sizeof(nav_data.node_clusters[0]) * nav_data.num_nodes, TAG_NAV);
+
+    for (i = 0; i < nav_data.num_nodes; i++) {
+        const nav_node_t *node = &nav_data.nodes[i];
+        int x = Nav_GridCoord(node->origin[0], nav_data.grid_origin[0], nav_data.grid_width) / NAV_CLUSTER_CELLS;
+        int y = Nav_GridCoord(node->origin[1], nav_data.grid_origin[1], nav_data.grid_height) / NAV_CLUSTER_CELLS;
+        int *cell = &cells[y * width + x];
+
+        if (*cell == -1)
+            *cell = nav_data.num_clusters++;
+        nav_data.node_clusters[i] = *cell;
+    }
+
+    gi.TagFree(cells);
+
+    // cluster origin is average of its nodes
+    int *counts = gi.TagMalloc(sizeof(counts[0]) * nav_data.num_clusters, TAG_NAV);
+    memset(counts, 0, sizeof(counts[0]) * nav_data.num_clusters);
+    nav_data.cluster_origins = gi.TagMalloc(sizeof(nav_data.cluster_origins[0]) * nav_data.num_clusters, TAG_NAV);
+    memset(nav_data.cluster_origins, 0, sizeof(nav_data.cluster_origins[0]) * nav_data.num_clusters);
+
+    for (i = 0; i < nav_data.num_nodes; i++) {
+        int c = nav_data.node_clusters[i];
+        VectorAdd(nav_data.cluster_origins[c], nav_data.nodes[i].origin, nav_data.cluster_origins[c]);
+        counts[c]++;
+    }
+
+    for (i = 0; i < nav_data.num_clusters; i++)
+        VectorScale(nav_data.cluster_origins[i], 1.0f / counts[i], nav_data.cluster_origins[i]);
+
+    gi.TagFree(counts);
+
+    // gather links crossing cluster borders, grouped by cluster pair
+    nav_portal_t *portals = gi.TagMalloc(sizeof(portals[0]) * nav_data.num_links, TAG_NAV);
+    num_portals = 0;
+
+    for (i = 0; i < nav_data.num_nodes; i++) {
+        const nav_node_t *node = &nav_data.nodes[i];
+        for (j = 0; j < node->num_links; j++) {
+            const nav_link_t *link = &node->links[j];
+            if (nav_data.node_clusters[i] == nav_data.node_clusters[link->target->id])
+                continue;
+            portals[num_portals].source = nav_data.node_clusters[i];
+            portals[num_portals].target = nav_data.node_clusters[link->target->id];
+            portals[num_portals].link = link - nav_data.links;
+            num_portals++;
+        }
+    }
+
+    qsort(portals, num_portals, sizeof(portals[0]), Nav_PortalCmp);
+
+    nav_data.cluster_first_edge = gi.TagMalloc(sizeof(nav_data.cluster_first_edge[0]) * (nav_data.num_clusters + 1), TAG_NAV);
+    nav_data.cluster_edges = gi.TagMalloc(sizeof(nav_data.cluster_edges[0]) * max(num_portals, 1), TAG_NAV);
+    nav_data.cluster_links = gi.TagMalloc(sizeof(nav_data.cluster_links[0]) * max(num_portals, 1), TAG_NAV);
+
+    nav_cluster_edge_t *edge = NULL;
+    int num_edges = 0;
+
+    for (i = 0, j = 0; i < nav_data.num_clusters; i++) {
+        nav_data.cluster_first_edge[i] = num_edges;
+
+        for (; j < num_portals && portals[j].source == i; j++) {
+            if (num_edges == nav_data.cluster_first_edge[i] || portals[j].target != portals[j - 1].target) {
+                edge = &nav_data.cluster_edges[num_edges++];
+                edge->target = portals[j].target;
+                edge->cost = DistanceSquared(nav_data.cluster_origins[i], nav_data.cluster_origins[edge->target]);
+                edge->first_link = j;
+                edge->num_links = 0;
+            }
+            nav_data.cluster_links[j] = portals[j].link;
+            edge->num_links++;
+        }
+    }
+
+    nav_data.cluster_first_edge[nav_data.num_clusters] = num_edges;
+    nav_data.num_cluster_links = num_portals;
+
+    gi.TagFree(portals);
+}
+
+/*
+==============================================================================
+
+NAV CACHE
+
+Everything Nav_Load builds is written out to a cache file next to the .nav
+file, keyed by hash of the source file. Lumps are laid out as the runtime
+arrays, except for pointers which are stored as index + 1 (0 for NULL).
+Loading a cache is a single file read and a relocation pass.
+
+==============================================================================
+*/
+
+#define NAV_CACHE_MAGIC     MakeLittleLong('N', 'A', 'V', 'C')
+#define NAV_CACHE_VERSION   1
+
+enum {
+    NAV_LUMP_NODES,
+    NAV_LUMP_LINKS,
+    NAV_LUMP_TRAVERSALS,
+    NAV_LUMP_EDICTS,
+    NAV_LUMP_CONDITIONAL_NODES,
+    NAV_LUMP_GRID_CELLS,
+    NAV_LUMP_GRID_NODES,
+    NAV_LUMP_NODE_CLUSTERS,
+    NAV_LUMP_CLUSTER_ORIGINS,
+    NAV_LUMP_CLUSTER_FIRST_EDGE,
+    NAV_LUMP_CLUSTER_EDGES,
+    NAV_LUMP_CLUSTER_LINKS,
+    NAV_LUMP_LINK_SOURCES,
+    NAV_LUMP_IN_FIRST,
+    NAV_LUMP_IN_LINKS,
+
+    NAV_LUMP_TOTAL
+};
+
+typedef struct {
+    uint32_t    magic;
+    uint32_t    version;
+    uint32_t    source_hash;
+    uint32_t    source_len;
+
+    // native struct sizes, cache isn't portable
+    uint8_t     struct_sizes[8];
+
+    uint32_t    num_nodes;
+    uint32_t    num_links;
+    uint32_t    num_traversals;
+    uint32_t    num_edicts;
+    uint32_t    num_conditional_nodes;
+    float       heuristic;
+
+    vec2_t      grid_origin;
+    float       grid_cell_size;
+    int32_t     grid_width, grid_height;
+
+    uint32_t    num_clusters;
+    uint32_t    num_cluster_links;
+
+    struct {
+        uint32_t    ofs, len;
+    } lumps[NAV_LUMP_TOTAL];
+} nav_cache_header_t;
+
+#define NAV_CACHE_ALIGN     16
+
+static uint32_t Nav_HashData(const void *data, size_t len)
+{
+    const byte *p = data;
+    uint32_t hash = 2166136261u;
+
+    while (len--)
+        hash = (hash ^ *p++) * 16777619u;
+
+    return hash;
+}
+
+static void Nav_StructSizes(uint8_t *sizes)
+{
+    sizes[0] = sizeof(void *);
+    sizes[1] = sizeof(nav_node_t);
+    sizes[2] = sizeof(nav_link_t);
+    sizes[3] = sizeof(nav_traversal_t);
+    sizes[4] = sizeof(nav_edict_t);
+    sizes[5] = sizeof(nav_cluster_edge_t);
+    sizes[6] = sizeof(vec3_t);
+    sizes[7] = 0;
+}
+
+static bool Nav_CacheName(char *buffer, size_t size, const char *mapname)
+{
+    return Q_snprintf(buffer, size, "bots/navigation/%s.navc", mapname) < size;
+}
+
+// pointer <-> index + 1 conversion
+#define NAV_INDEX(ptr, base) \
+    ((void *)(uintptr_t)((ptr) ? (ptr) - (base) + 1 : 0))
+
+#define NAV_RELOC(ptr, base, count) \
+    do { \
+        uintptr_t index_ = (uintptr_t)(ptr); \
+        if (index_ > (count)) \
+            return false; \
+        (ptr) = index_ ? &(base)[index_ - 1] : NULL; \
+    } while (0)
+
+static void Nav_WriteCache(const char *mapname, uint32_t hash, uint32_t len)
+{
+    nav_cache_header_t header = {
+        .magic = NAV_CACHE_MAGIC,
+        .version = NAV_CACHE_VERSION,
+        .source_hash = hash,
+        .source_len = len,
+        .num_nodes = nav_data.num_nodes,
+        .num_links = nav_data.num_links,
+        .num_traversals = nav_data.num_traversals,
+        .num_edicts = nav_data.num_edicts,
+        .num_conditional_nodes = nav_data.num_conditional_nodes,
+        .heuristic = nav_data.heuristic,
+        .grid_origin = { nav_data.grid_origin[0], nav_data.grid_origin[1] },
+        .grid_cell_size = nav_data.grid_cell_size,
+        .grid_width = nav_data.grid_width,
+        .grid_height = nav_data.grid_height,
+        .num_clusters = nav_data.num_clusters,
+        .num_cluster_links = nav_data.num_cluster_links,
+    };
+    const void *lumps[NAV_LUMP_TOTAL];
+    uint32_t i, ofs;
+    char filename[MAX_QPATH];
+    qhandle_t f;
+
+    if (!Nav_CacheName(filename, sizeof(filename), mapname))
+        return;
+
+    Nav_StructSizes(header.struct_sizes);
+
+    // make copies with pointers converted to indices
+    nav_node_t *nodes = gi.TagMalloc(sizeof(nodes[0]) * nav_data.num_nodes, TAG_NAV);
+    for (i = 0; i < nav_data.num_nodes; i++) {
+        nodes[i] = nav_data.nodes[i];
+        nodes[i].links = NAV_INDEX(nodes[i].links, nav_data.links);
+    }
+
+    nav_link_t *links = gi.TagMalloc(sizeof(links[0]) * nav_data.num_links, TAG_NAV);
+    for (i = 0; i < nav_data.num_links; i++) {
+        links[i] = nav_data.links[i];
+        links[i].target = NAV_INDEX(links[i].target, nav_data.nodes);
+        links[i].traversal = NAV_INDEX(links[i].traversal, nav_data.traversals);
+        links[i].edict = NAV_INDEX(links[i].edict, nav_data.edicts);
+    }
+
+    nav_edict_t *edicts = gi.TagMalloc(sizeof(edicts[0]) * max(nav_data.num_edicts, 1), TAG_NAV);
+    for (i = 0; i < nav_data.num_edicts; i++) {
+        edicts[i] = nav_data.edicts[i];
+        edicts[i].link = NAV_INDEX(edicts[i].link, nav_data.links);
+        edicts[i].game_edict = NULL;
+    }
+
+    nav_node_t **conditional_nodes = gi.TagMalloc(sizeof(conditional_nodes[0]) * max(nav_data.num_conditional_nodes, 1), TAG_NAV);
+    for (i = 0; i < nav_data.num_conditional_nodes; i++)
+        conditional_nodes[i] = NAV_INDEX(nav_data.conditional_nodes[i], nav_data.nodes);
+
+    uint32_t num_cells = nav_data.grid_width * nav_data.grid_height;
+    uint32_t num_edges = nav_data.cluster_first_edge[nav_data.num_clusters];
+
+#define LUMP(n, p, count) \
+    (lumps[n] = (p), header.lumps[n].len = sizeof((p)[0]) * (count))
+
+    LUMP(NAV_LUMP_NODES, nodes, nav_data.num_nodes);
+    LUMP(NAV_LUMP_LINKS, links, nav_data.num_links);
+    LUMP(NAV_LUMP_TRAVERSALS, nav_data.traversals, nav_data.num_traversals);
+    LUMP(NAV_LUMP_EDICTS, edicts, nav_data.num_edicts);
+    LUMP(NAV_LUMP_CONDITIONAL_NODES, conditional_nodes, nav_data.num_conditional_nodes);
+    LUMP(NAV_LUMP_GRID_CELLS, nav_data.grid_cells, num_cells + 1);
+    LUMP(NAV_LUMP_GRID_NODES, nav_data.grid_nodes, nav_data.num_nodes);
+    LUMP(NAV_LUMP_NODE_CLUSTERS, nav_data.node_clusters, nav_data.num_nodes);
+    LUMP(NAV_LUMP_CLUSTER_ORIGINS, nav_data.cluster_origins, nav_data.num_clusters);
+    LUMP(NAV_LUMP_CLUSTER_FIRST_EDGE, nav_data.cluster_first_edge, nav_data.num_clusters + 1);
+    LUMP(NAV_LUMP_CLUSTER_EDGES, nav_data.cluster_edges, num_edges);
+    LUMP(NAV_LUMP_CLUSTER_LINKS, nav_data.cluster_links, nav_data.num_cluster_links);
+    LUMP(NAV_LUMP_LINK_SOURCES, nav_data.link_sources, nav_data.num_links);
+    LUMP(NAV_LUMP_IN_FIRST, nav_data.in_first, nav_data.num_nodes + 1);
+    LUMP(NAV_LUMP_IN_LINKS, nav_data.in_links, nav_data.num_links);
+
+#undef LUMP
+
+    ofs = Q_ALIGN(sizeof(header), NAV_CACHE_ALIGN);
+    for (i = 0; i < NAV_LUMP_TOTAL; i++) {
+        header.lumps[i].ofs = ofs;
+        ofs = Q_ALIGN(ofs + header.lumps[i].len, NAV_CACHE_ALIGN);
+    }
+
+    if (fs->OpenFile(filename, &f, FS_MODE_WRITE) < 0) {
+        gi.dprintf("Couldn't write %s\n", filename);
+        goto done;
+    }
+
+    static const byte pad[NAV_CACHE_ALIGN];
+    bool ok = fs->WriteFile(&header, sizeof(header), f) == sizeof(header);
+    ofs = sizeof(header);
+
+    for (i = 0; i < NAV_LUMP_TOTAL && ok; i++) {
+        ok &= fs->WriteFile(pad, header.lumps[i].ofs - ofs, f) >= 0;
+        ok &= fs->WriteFile(lumps[i], header.lumps[i].len, f) == header.lumps[i].len;
+        ofs = header.lumps[i].ofs + header.lumps[i].len;
+    }
+
+    if (fs->CloseFile(f) < 0)
+        ok = false;
+
+    if (!ok)
+        gi.dprintf("Couldn't write %s\n", filename);
+
+done:
+    gi.TagFree(nodes);
+    gi.TagFree(links);
+    gi.TagFree(edicts);
+    gi.TagFree(conditional_nodes);
+}
+
+static void *Nav_CacheLump(byte *data, const nav_cache_header_t *header, int lump, size_t size, uint32_t count)
+{
+    if (header->lumps[lump].len != size * count)
+        return NULL;
+
+    // non-NULL for empty lumps too
+    return data + header->lumps[lump].ofs;
+}
+
+static bool Nav_RelocateCache(byte *data, const nav_cache_header_t *header)
+{
+    uint32_t i, num_cells = nav_data.grid_width * nav_data.grid_height;
+
+#define LUMP(p, n, count) \
+    if (!((p) = Nav_CacheLump(data, header, n, sizeof((p)[0]), count))) \
+        return false
+
+    LUMP(nav_data.nodes, NAV_LUMP_NODES, nav_data.num_nodes);
+    LUMP(nav_data.links, NAV_LUMP_LINKS, nav_data.num_links);
+    LUMP(nav_data.traversals, NAV_LUMP_TRAVERSALS, nav_data.num_traversals);
+    LUMP(nav_data.edicts, NAV_LUMP_EDICTS, nav_data.num_edicts);
+    LUMP(nav_data.conditional_nodes, NAV_LUMP_CONDITIONAL_NODES, nav_data.num_conditional_nodes);
+    LUMP(nav_data.grid_cells, NAV_LUMP_GRID_CELLS, num_cells + 1);
+    LUMP(nav_data.grid_nodes, NAV_LUMP_GRID_NODES, nav_data.num_nodes);
+    LUMP(nav_data.node_clusters, NAV_LUMP_NODE_CLUSTERS, nav_data.num_nodes);
+    LUMP(nav_data.cluster_origins, NAV_LUMP_CLUSTER_ORIGINS, nav_data.num_clusters);
+    LUMP(nav_data.cluster_first_edge, NAV_LUMP_CLUSTER_FIRST_EDGE, nav_data.num_clusters + 1);
+    LUMP(nav_data.cluster_edges, NAV_LUMP_CLUSTER_EDGES, nav_data.cluster_first_edge[nav_data.num_clusters]);
+    LUMP(nav_data.cluster_links, NAV_LUMP_CLUSTER_LINKS, nav_data.num_cluster_links);
+    LUMP(nav_data.link_sources, NAV_LUMP_LINK_SOURCES, nav_data.num_links);
+    LUMP(nav_data.in_first, NAV_LUMP_IN_FIRST, nav_data.num_nodes + 1);
+    LUMP(nav_data.in_links, NAV_LUMP_IN_LINKS, nav_data.num_links);
+
+#undef LUMP
+
+    for (i = 0; i < nav_data.num_nodes; i++) {
+        nav_node_t *node = &nav_data.nodes[i];
+
+        // links pointer may point one past the end if node has no links
+        NAV_RELOC(node->links, nav_data.links, nav_data.num_links + 1);
+        if (!node->links || node->num_links < 0 ||
+            node->num_links > nav_data.links + nav_data.num_links - node->links)
+            return false;
+        if (node->id != i || nav_data.grid_nodes[i] >= nav_data.num_nodes)
+            return false;
+        if (nav_data.node_clusters[i] >= nav_data.num_clusters)
+            return false;
+    }
+
+    for (i = 0; i < nav_data.num_links; i++) {
+        nav_link_t *link = &nav_data.links[i];
+
+        NAV_RELOC(link->target, nav_data.nodes, nav_data.num_nodes);
+        NAV_RELOC(link->traversal, nav_data.traversals, nav_data.num_traversals);
+        NAV_RELOC(link->edict, nav_data.edicts, nav_data.num_edicts);
+        if (!link->target)
+            return false;
+        if (nav_data.link_sources[i] >= nav_data.num_nodes || nav_data.in_links[i] >= nav_data.num_links)
+            return false;
+    }
+
+    for (i = 0; i < nav_data.num_edicts; i++) {
+        NAV_RELOC(nav_data.edicts[i].link, nav_data.links, nav_data.num_links);
+        if (!nav_data.edicts[i].link)
+            return false;
+    }
+
+    for (i = 0; i < nav_data.num_conditional_nodes; i++) {
+        NAV_RELOC(nav_data.conditional_nodes[i], nav_data.nodes, nav_data.num_nodes);
+        if (!nav_data.conditional_nodes[i])
+            return false;
+    }
+
+    // offset tables must be monotonic and end at their array size
+    for (i = 0; i < num_cells; i++)
+        if (nav_data.grid_cells[i] > nav_data.grid_cells[i + 1])
+            return false;
+    if (nav_data.grid_cells[0] || nav_data.grid_cells[num_cells] != nav_data.num_nodes)
+        return false;
+
+    for (i = 0; i < nav_data.num_nodes; i++)
+        if (nav_data.in_first[i] > nav_data.in_first[i + 1])
+            return false;
+    if (nav_data.in_first[0] || nav_data.in_first[nav_data.num_nodes] != nav_data.num_links)
+        return false;
+
+    for (i = 0; i < nav_data.num_clusters; i++)
+        if (nav_data.cluster_first_edge[i] > nav_data.cluster_first_edge[i + 1])
+            return false;
+    if (nav_data.cluster_first_edge[0])
+        return false;
+
+    for (i = 0; i < nav_data.cluster_first_edge[nav_data.num_clusters]; i++) {
+        const nav_cluster_edge_t *edge = &nav_data.cluster_edges[i];
+        if (edge->target >= nav_data.num_clusters)
+            return false;
+        if (edge->first_link > nav_data.num_cluster_links ||
+            edge->num_links > nav_data.num_cluster_links - edge->first_link)
+            return false;
+    }
+
+    for (i = 0; i < nav_data.num_cluster_links; i++)
+        if (nav_data.cluster_links[i] >= nav_data.num_links)
+            return false;
+
+    return true;
+}
+
+static bool Nav_LoadCache(const char *mapname, uint32_t hash, uint32_t len)
+{
+    char filename[MAX_QPATH];
+    uint8_t struct_sizes[8];
+    void *buffer;
+    byte *data;
+    int i;
+
+    if (!Nav_CacheName(filename, sizeof(filename), mapname))
+        return false;
+
+    int cache_len = fs->LoadFile(filename, &buffer, 0, TAG_NAV);
+    if (!buffer)
+        return false;
+
+    data = buffer;
+    Nav_StructSizes(struct_sizes);
+
+    const nav_cache_header_t *header = buffer;
+    if (cache_len < sizeof(*header) || header->magic != NAV_CACHE_MAGIC ||
+        header->version != NAV_CACHE_VERSION || header->source_hash != hash ||
+        header->source_len != len || memcmp(header->struct_sizes, struct_sizes, sizeof(struct_sizes)))
+        goto fail;
+
+    for (i = 0; i < NAV_LUMP_TOTAL; i++) {
+        if (header->lumps[i].ofs % NAV_CACHE_ALIGN)
+            goto fail;
+        if (header->lumps[i].ofs > cache_len || header->lumps[i].len > cache_len - header->lumps[i].ofs)
+            goto fail;
+    }
+
+    if (!header->num_nodes || header->num_nodes > INVALID_ID)
+        goto fail;
+    if (header->num_links > INVALID_ID || header->num_traversals > INVALID_ID)
+        goto fail;
+    if (header->num_edicts > MAX_EDICTS || header->num_conditional_nodes > header->num_nodes)
+        goto fail;
+    if (header->grid_width < 1 || header->grid_width > NAV_GRID_MAX_SIZE)
+        goto fail;
+    if (header->grid_height < 1 || header->grid_height > NAV_GRID_MAX_SIZE)
+        goto fail;
+    if (header->num_clusters > header->num_nodes || header->num_cluster_links > header->num_links)
+        goto fail;
+
+    nav_data.num_nodes = header->num_nodes;
+    nav_data.num_links = header->num_links;
+    nav_data.num_traversals = header->num_traversals;
+    nav_data.num_edicts = header->num_edicts;
+    nav_data.num_conditional_nodes = header->num_conditional_nodes;
+    nav_data.heuristic = header->heuristic;
+    nav_data.grid_origin[0] = header->grid_origin[0];
+    nav_data.grid_origin[1] = header->grid_origin[1];
+    nav_data.grid_cell_size = header->grid_cell_size;
+    nav_data.grid_width = header->grid_width;
+    nav_data.grid_height = header->grid_height;
+    nav_data.num_clusters = header->num_clusters;
+    nav_data.num_cluster_links = header->num_cluster_links;
+
+    if (!Nav_RelocateCache(data, header))
+        goto fail;
+
+    gi.dprintf("Loaded %s: %u nodes, %u links, %u traversals, %u edicts\n",
+               filename, nav_data.num_nodes, nav_data.num_links, nav_data.num_traversals, nav_data.num_edicts);
+    return true;
+
+fail:
+    gi.dprintf("Ignoring stale or invalid %s\n", filename);
+    gi.TagFree(buffer);
+    memset(&nav_data, 0, sizeof(nav_data));
+    return false;
 }
 
 typedef struct {
@@ -248,6 +1068,8 @@ static void Nav_ReadVector(nav_buffer_t *b, vec3_t v)
     v[2] = Nav_ReadFloat(b);
 }
 
+static void Nav_BuildHopTable(void);
+
 #define NAV_VERIFY(condition, error) \
     if (!(condition)) { err = error; goto fail; }
 
@@ -275,6 +1097,13 @@ void Nav_Load(const char *mapname)
     if (!data)
         return;
 
+    uint32_t hash = Nav_HashData(data, len);
+
+    if (nav_cache->integer && Nav_LoadCache(mapname, hash, len)) {
+        gi.TagFree(data);
+        goto done;
+    }
+
     NAV_VERIFY(len >= 7*4, "File too small");
 
     nav_buffer_t b;
@@ -389,7 +1218,16 @@ void Nav_Load(const char *mapname)
                filename, v, nav_data.num_nodes, nav_data.num_links, nav_data.num_traversals, nav_data.num_edicts);
 
     gi.TagFree(data);
-    Nav_AllocContext(&nav_data.ctx);
+    Nav_BuildGrid();
+    Nav_BuildClusters();
+    Nav_BuildIncomingLinks();
+
+    if (nav_cache->integer)
+        Nav_WriteCache(mapname, hash, len);
+
+done:
+    Nav_AllocRuntime();
+    Nav_BuildHopTable();
     return;
 
 fail:
@@ -484,58 +1322,232 @@ static bool Nav_LinkAccessible(const nav_path_t *path, const nav_node_t *node, c
 #define Dot2Product(x,y)        ((x)[0]*(y)[0]+(x)[1]*(y)[1])
 #define Vector2Length(v)        (sqrtf(Dot2Product((v),(v))))
 
-static const nav_node_t *Nav_ClosestNodeTo(nav_path_t *path, const vec3_t p)
+// parameters for Nav_FilterSlots
+typedef struct {
+    vec3_t      origin;
+    float       radius_sq;
+    float       min_z, max_z;
+    uint32_t    reject_flags;
+} nav_filter_t;
+
+// returns bitmask of NAV_FILTER_WIDTH slots starting at i that are within
+// radius on XY plane and within height window, and don't have any of the
+// reject flags. squared XY distances are stored in dist_sq.
+static inline int Nav_FilterBlock(const nav_filter_t *f, uint32_t i, float *dist_sq)
 {
-    const PathRequest *req = path->request;
-    float w = INFINITY;
-    const nav_node_t *c = NULL;
-
-    float min_z = p[2] - req->nodeSearch.minHeight;
-    float max_z = p[2] + req->nodeSearch.maxHeight;
-
-    for (int i = 0; i < nav_data.num_nodes; i++) {
-        const nav_node_t *node = &nav_data.nodes[i];
-        if (!Nav_NodeAccessible(path, node))
-            continue;
+#if USE_NAV_SSE2
+    __m128 dx = _mm_sub_ps(_mm_loadu_ps(&nav_data.slot_x[i]), _mm_set1_ps(f->origin[0]));
+    __m128 dy = _mm_sub_ps(_mm_loadu_ps(&nav_data.slot_y[i]), _mm_set1_ps(f->origin[1]));
+    __m128 z  = _mm_loadu_ps(&nav_data.slot_z[i]);
+    __m128 d  = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+    __m128 m = _mm_cmple_ps(d, _mm_set1_ps(f->radius_sq));
+    m = _mm_and_ps(m, _mm_cmpge_ps(z, _mm_set1_ps(f->min_z)));
+    m = _mm_and_ps(m, _mm_cmple_ps(z, _mm_set1_ps(f->max_z)));
+
+    __m128i fl = _mm_loadl_epi64((const __m128i *)&nav_data.slot_flags[i]);
+    fl = _mm_unpacklo_epi16(fl, _mm_setzero_si128());
+    fl = _mm_and_si128(fl, _mm_set1_epi32(f->reject_flags));
+    m = _mm_and_ps(m, _mm_castsi128_ps(_mm_cmpeq_epi32(fl, _mm_setzero_si128())));
+
+    _mm_storeu_ps(dist_sq, d);
+    return _mm_movemask_ps(m);
+#elif USE_NAV_NEON
+    static const uint32_t lanes[4] = { 1, 2, 4, 8 };
+    float32x4_t dx = vsubq_f32(vld1q_f32(&nav_data.slot_x[i]), vdupq_n_f32(f->origin[0]));
+    float32x4_t dy = vsubq_f32(vld1q_f32(&nav_data.slot_y[i]), vdupq_n_f32(f->origin[1]));
+    float32x4_t z  = vld1q_f32(&nav_data.slot_z[i]);
+    float32x4_t d  = vmlaq_f32(vmulq_f32(dx, dx), dy, dy);
+
+    uint32x4_t m = vcleq_f32(d, vdupq_n_f32(f->radius_sq));
+    m = vandq_u32(m, vcgeq_f32(z, vdupq_n_f32(f->min_z)));
+    m = vandq_u32(m, vcleq_f32(z, vdupq_n_f32(f->max_z)));
+
+    uint32x4_t fl = vmovl_u16(vld1_u16(&nav_data.slot_flags[i]));
+    m = vandq_u32(m, vceqq_u32(vandq_u32(fl, vdupq_n_u32(f->reject_flags)), vdupq_n_u32(0)));
+    m = vandq_u32(m, vld1q_u32(lanes));
+
+    uint32x2_t sum = vpadd_u32(vget_low_u32(m), vget_high_u32(m));
+    vst1q_f32(dist_sq, d);
+    return vget_lane_u32(vpadd_u32(sum, sum), 0);
+#else
+    int mask = 0;
+
+    for (int j = 0; j < NAV_FILTER_WIDTH; j++) {
+        float dx = nav_data.slot_x[i + j] - f->origin[0];
+        float dy = nav_data.slot_y[i + j] - f->origin[1];
+        float z = nav_data.slot_z[i + j];
+
+        dist_sq[j] = dx * dx + dy * dy;
+        if (dist_sq[j] <= f->radius_sq && z >= f->min_z && z <= f->max_z &&
+            !(nav_data.slot_flags[i + j] & f->reject_flags))
+            mask |= BIT(j);
+    }
 
-        if (node->origin[2] < min_z || node->origin[2] > max_z)
-            continue;
+    return mask;
+#endif
+}
 
-        vec2_t d;
-        Vector2Subtract(node->origin, p, d);
+// appends nodes in slots [first, last) that pass the filter to candidate
+// list, returns new number of candidates
+static int Nav_FilterSlots(const nav_filter_t *f, uint32_t first, uint32_t last, nav_candidate_t *cand, int num_cand)
+{
+    float dist_sq[NAV_FILTER_WIDTH];
 
-        float l = Vector2Length(d);
-        if (l > req->nodeSearch.radius)
-            continue;
+    for (uint32_t i = first; i < last; i += NAV_FILTER_WIDTH) {
+        int mask = Nav_FilterBlock(f, i, dist_sq);
 
-        vec3_t end = { 0, 0, 32 };
-        VectorAdd(end, node->origin, end);
-        trace_t tr = gi.trace(p, NULL, NULL, end, NULL, MASK_SOLID | CONTENTS_PLAYERCLIP | CONTENTS_MONSTERCLIP);
-        if (tr.fraction < 1.0f)
-            continue;
+        // block may extend past the end of range
+        if (last - i < NAV_FILTER_WIDTH)
+            mask &= BIT(last - i) - 1;
 
-        if (l < w) {
-            w = l;
-            c = node;
+        for (int j = 0; mask; j++, mask >>= 1) {
+            if (!(mask & 1))
+                continue;
+            cand[num_cand].dist = sqrtf(dist_sq[j]);
+            cand[num_cand].id = nav_data.grid_nodes[i + j];
+            num_cand++;
         }
     }
 
-    return c;
+    return num_cand;
 }
 
-static const nav_link_t *Nav_GetLink(const nav_node_t *a, const nav_node_t *b)
+// node flags that make node inaccessible regardless of path flags,
+// used to filter out nodes early
+static uint32_t Nav_RejectFlags(const nav_path_t *path)
 {
-    for (const nav_link_t *link = a->links; link != a->links + a->num_links; link++)
-        if (link->target == b)
-            return link;
+    const PathRequest *req = path->request;
+    uint32_t flags = NodeFlag_Disabled;
 
-    return NULL;
+    if (req->nodeSearch.ignoreNodeFlags)
+        return flags | NodeFlag_NoPOI;
+
+    flags |= NodeFlag_NoMonsters | NodeFlag_Crouch | NodeFlag_Ladder | NodeFlag_Elevator | NodeFlag_Pusher | NodeFlag_Teleporter;
+
+    if (!(req->pathFlags & PathFlags_Water))
+        flags |= NodeFlag_UnderWater;
+
+    return flags;
 }
 
-static bool Nav_TouchingNode(const vec3_t pos, float move_dist, const nav_node_t *node)
+static int Nav_CandidateCmp(const void *p1, const void *p2)
 {
-    return Distance(node->origin, pos) <= move_dist;
-}
+    const nav_candidate_t *a = p1;
+    const nav_candidate_t *b = p2;
+
+    if (a->dist != b->dist)
+        return a->dist < b->dist ? -1 : 1;
+
+    return (int)a->id - (int)b->id;
+}
+
+static nav_closest_t *Nav_FindClosest(const PathRequest *req, const vec3_t p)
+{
+    PathFlags path_flags = req->pathFlags & (PathFlags_Walk | PathFlags_Water);
+
+    for (int i = 0; i < nav_data.num_closest; i++) {
+        nav_closest_t *c = &nav_data.closest[i];
+        if (c->time == level.time && VectorCompare(c->pos, p) &&
+            c->ignore_flags == req->nodeSearch.ignoreNodeFlags && c->path_flags == path_flags &&
+            c->min_height == req->nodeSearch.minHeight && c->max_height == req->nodeSearch.maxHeight &&
+            c->radius == req->nodeSearch.radius)
+            return c;
+    }
+
+    return NULL;
+}
+
+static void Nav_CacheClosest(const PathRequest *req, const vec3_t p, const nav_node_t *node)
+{
+    nav_closest_t *c = &nav_data.closest[nav_data.next_closest++ % NAV_MAX_CLOSEST];
+
+    VectorCopy(p, c->pos);
+    c->time = level.time;
+    c->ignore_flags = req->nodeSearch.ignoreNodeFlags;
+    c->path_flags = req->pathFlags & (PathFlags_Walk | PathFlags_Water);
+    c->min_height = req->nodeSearch.minHeight;
+    c->max_height = req->nodeSearch.maxHeight;
+    c->radius = req->nodeSearch.radius;
+    c->node = node;
+
+    nav_data.num_closest = min(nav_data.num_closest + 1, NAV_MAX_CLOSEST);
+}
+
+// finds the closest accessible node within search radius that can be
+// traced to. candidates are traced in increasing order of distance
+// (ties broken by node id), so the first one that passes is the result.
+static const nav_node_t *Nav_ClosestNodeTo(nav_path_t *path, const vec3_t p)
+{
+    const PathRequest *req = path->request;
+    const nav_closest_t *cached = Nav_FindClosest(req, p);
+    nav_candidate_t *cand = nav_data.candidates;
+    const nav_node_t *c = NULL;
+    int num_cand = 0;
+
+    if (cached)
+        return cached->node;
+
+    float r = req->nodeSearch.radius;
+    nav_filter_t filter = {
+        .origin = { p[0], p[1], p[2] },
+        .radius_sq = r * r,
+        .min_z = p[2] - req->nodeSearch.minHeight,
+        .max_z = p[2] + req->nodeSearch.maxHeight,
+        .reject_flags = Nav_RejectFlags(path),
+    };
+
+    int x0 = Nav_GridCoord(p[0] - r, nav_data.grid_origin[0], nav_data.grid_width);
+    int y0 = Nav_GridCoord(p[1] - r, nav_data.grid_origin[1], nav_data.grid_height);
+    int x1 = Nav_GridCoord(p[0] + r, nav_data.grid_origin[0], nav_data.grid_width);
+    int y1 = Nav_GridCoord(p[1] + r, nav_data.grid_origin[1], nav_data.grid_height);
+
+    // cells of each row are adjacent in slot order
+    for (int y = y0; y <= y1; y++) {
+        int row = y * nav_data.grid_width;
+        num_cand = Nav_FilterSlots(&filter, nav_data.grid_cells[row + x0],
+                                   nav_data.grid_cells[row + x1 + 1], cand, num_cand);
+    }
+
+    // filter doesn't check everything
+    int n = 0;
+    for (int i = 0; i < num_cand; i++)
+        if (Nav_NodeAccessible(path, &nav_data.nodes[cand[i].id]))
+            cand[n++] = cand[i];
+    num_cand = n;
+
+    qsort(cand, num_cand, sizeof(cand[0]), Nav_CandidateCmp);
+
+    for (int i = 0; i < num_cand; i++) {
+        const nav_node_t *node = &nav_data.nodes[cand[i].id];
+
+        vec3_t end = { 0, 0, 32 };
+        VectorAdd(end, node->origin, end);
+        trace_t tr = gi.trace(p, NULL, NULL, end, NULL, MASK_SOLID | CONTENTS_PLAYERCLIP | CONTENTS_MONSTERCLIP);
+        if (tr.fraction < 1.0f)
+            continue;
+
+        c = node;
+        break;
+    }
+
+    Nav_CacheClosest(req, p, c);
+    return c;
+}
+
+static const nav_link_t *Nav_GetLink(const nav_node_t *a, const nav_node_t *b)
+{
+    for (const nav_link_t *link = a->links; link != a->links + a->num_links; link++)
+        if (link->target == b)
+            return link;
+
+    return NULL;
+}
+
+static bool Nav_TouchingNode(const vec3_t pos, float move_dist, const nav_node_t *node)
+{
+    return Distance(node->origin, pos) <= move_dist;
+}
 
 static bool Nav_NodeReached(const vec3_t pos, const nav_node_t *node)
 {
@@ -545,32 +1557,110 @@ static bool Nav_NodeReached(const vec3_t pos, const nav_node_t *node)
     return Vector2Length(d) <= node->radius && fabsf(d[2]) <= 64;
 }
 
-static void Nav_PushOpenSet(nav_ctx_t *ctx, const nav_node_t *node, float f)
+static inline bool Nav_OpenLess(const nav_open_t *a, const nav_open_t *b)
 {
-    if (LIST_EMPTY(&ctx->open_set_free))
-        return;
+    if (a->f_score != b->f_score)
+        return a->f_score < b->f_score;
+    return a->seq < b->seq;
+}
 
-    // grab free entry
-    nav_open_t *o = LIST_FIRST(nav_open_t, &ctx->open_set_free, entry);
-    List_Remove(&o->entry);
+static void Nav_OpenSiftUp(nav_ctx_t *ctx, uint32_t i)
+{
+    nav_open_t o = ctx->open_set[i];
 
-    o->node = node;
-    o->f_score = f;
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (!Nav_OpenLess(&o, &ctx->open_set[parent]))
+            break;
+        ctx->open_set[i] = ctx->open_set[parent];
+        ctx->open_pos[ctx->open_set[i].node] = i + 1;
+        i = parent;
+    }
+
+    ctx->open_set[i] = o;
+    ctx->open_pos[o.node] = i + 1;
+}
 
-    nav_open_t *open_where;
-    LIST_FOR_EACH(nav_open_t, open_where, &ctx->open_set_head, entry)
-        if (f < open_where->f_score)
+static void Nav_OpenSiftDown(nav_ctx_t *ctx, uint32_t i)
+{
+    nav_open_t o = ctx->open_set[i];
+
+    while (true) {
+        uint32_t child = i * 2 + 1;
+        if (child >= ctx->num_open)
+            break;
+        if (child + 1 < ctx->num_open && Nav_OpenLess(&ctx->open_set[child + 1], &ctx->open_set[child]))
+            child++;
+        if (!Nav_OpenLess(&ctx->open_set[child], &o))
             break;
+        ctx->open_set[i] = ctx->open_set[child];
+        ctx->open_pos[ctx->open_set[i].node] = i + 1;
+        i = child;
+    }
+
+    ctx->open_set[i] = o;
+    ctx->open_pos[o.node] = i + 1;
+}
+
+// insert node into open set, or move it up if it's already there.
+// f_score only ever decreases for a node that is already open.
+static void Nav_PushOpenSet(nav_ctx_t *ctx, int id, float f)
+{
+    uint32_t i = ctx->open_pos[id];
+
+    if (!i) {
+        Q_assert(ctx->num_open < nav_data.num_nodes);
+        i = ++ctx->num_open;
+        ctx->open_set[i - 1].node = id;
+    }
+
+    // re-pushed nodes go behind their equals, same as new ones
+    ctx->open_set[i - 1].f_score = f;
+    ctx->open_set[i - 1].seq = ctx->open_seq++;
+    Nav_OpenSiftUp(ctx, i - 1);
+}
+
+static void Nav_BeginSearch(nav_ctx_t *ctx)
+{
+    // only sweep on wraparound
+    if (!++ctx->generation) {
+        memset(ctx->node_gen, 0, sizeof(ctx->node_gen[0]) * nav_data.num_nodes);
+        ctx->generation = 1;
+    }
+
+    ctx->num_open = 0;
+    ctx->open_seq = 0;
+}
+
+static inline void Nav_TouchNode(nav_ctx_t *ctx, int id)
+{
+    if (ctx->node_gen[id] == ctx->generation)
+        return;
+
+    ctx->node_gen[id] = ctx->generation;
+    ctx->g_score[id] = INFINITY;
+    ctx->open_pos[id] = 0;
+}
+
+static int Nav_PopOpenSet(nav_ctx_t *ctx)
+{
+    int node = ctx->open_set[0].node;
+
+    ctx->open_pos[node] = 0;
+    if (--ctx->num_open) {
+        ctx->open_set[0] = ctx->open_set[ctx->num_open];
+        Nav_OpenSiftDown(ctx, 0);
+    }
 
-    List_Append(&open_where->entry, &o->entry);
+    return node;
 }
 
 #define PATH_POINT_TOO_CLOSE (64 * 64)
 
+static void Nav_FinishPath(nav_path_t *path, int current, int num_points);
+
 static void Nav_ReachedGoal(nav_path_t *path, int current)
 {
-    const PathRequest *request = path->request;
-    PathInfo *info = path->info;
     nav_ctx_t *ctx = path->ctx;
     int num_points = 0;
 
@@ -589,12 +1679,25 @@ static void Nav_ReachedGoal(nav_path_t *path, int current)
         p++;
     }
 
+    Nav_FinishPath(path, current, num_points);
+}
+
+// went_to holds num_points nodes from start up to (but not including) goal
+static void Nav_FinishPath(nav_path_t *path, int current, int num_points)
+{
+    const PathRequest *request = path->request;
+    PathInfo *info = path->info;
+    nav_ctx_t *ctx = path->ctx;
+    int p;
+
     // num_points now contains points between start
     // and current; it will be at least 1, since start can't
     // be the same as end, but may be less once we start clipping.
     Q_assert(num_points >= 1);
     Q_assert(ctx->went_to[0] != INVALID_ID);
 
+    path->num_points = num_points;
+
     int first_point = 0;
     const nav_link_t *link = NULL;
 
@@ -662,86 +1765,178 @@ static void Nav_ReachedGoal(nav_path_t *path, int current)
     }
 }
 
-static void Nav_Path(nav_path_t *path)
+// finds start and goal nodes, returns false if
+// info is already final and no search is needed
+static bool Nav_SetupPath(nav_path_t *path)
 {
     const PathRequest *request = path->request;
     PathInfo *info = path->info;
-    nav_ctx_t *ctx = path->ctx;
 
     memset(info, 0, sizeof(*info));
 
     if (!nav_data.nodes) {
         info->returnCode = PathReturnCode_NoNavAvailable;
-        return;
+        return false;
     }
 
     if (!(request->pathFlags & (PathFlags_Walk | PathFlags_Water))) {
         info->returnCode = PathReturnCode_MissingWalkOrSwimFlag;
-        return;
+        return false;
     }
 
     path->start = Nav_ClosestNodeTo(path, request->start);
     if (!path->start) {
         info->returnCode = PathReturnCode_NoStartNode;
-        return;
+        return false;
     }
 
     path->goal = Nav_ClosestNodeTo(path, request->goal);
     if (!path->goal) {
         info->returnCode = PathReturnCode_NoGoalNode;
-        return;
+        return false;
     }
 
     if (path->start == path->goal || Nav_TouchingNode(request->start, request->moveDist, path->goal)) {
         info->returnCode = PathReturnCode_ReachedGoal;
         VectorCopy(request->goal, info->firstMovePoint);
         VectorCopy(request->goal, info->secondMovePoint);
-        return;
+        return false;
     }
 
     if (!request->nodeSearch.ignoreNodeFlags) {
         if (gi.pointcontents(request->start) & MASK_SOLID) {
             info->returnCode = PathReturnCode_InvalidStart;
-            return;
+            return false;
         }
         if (gi.pointcontents(request->goal) & MASK_SOLID) {
             info->returnCode = PathReturnCode_InvalidGoal;
-            return;
+            return false;
         }
     }
 
-    int start_id = path->start->id;
-    int goal_id = path->goal->id;
+    return true;
+}
 
-    for (int i = 0; i < nav_data.num_nodes; i++)
-        ctx->g_score[i] = INFINITY;
+static bool Nav_ClusterEdgeAccessible(const nav_path_t *path, const nav_cluster_edge_t *edge)
+{
+    for (int i = 0; i < edge->num_links; i++) {
+        const nav_link_t *link = &nav_data.links[nav_data.cluster_links[edge->first_link + i]];
+        const nav_node_t *node = &nav_data.nodes[nav_data.link_sources[link - nav_data.links]];
 
-    List_Init(&ctx->open_set_head);
-    List_Init(&ctx->open_set_free);
+        if (Nav_NodeAccessible(path, node) && Nav_LinkAccessible(path, node, link))
+            return true;
+    }
 
-    for (int i = 0; i < nav_data.num_nodes; i++)
-        List_Append(&ctx->open_set_free, &ctx->open_set[i].entry);
+    return false;
+}
+
+// coarse A* search over clusters. edge accessibility is evaluated for
+// each request, so the result always reflects current node and link
+// state. on success, marks clusters along the way in ctx corridor.
+static bool Nav_FindCorridor(nav_path_t *path)
+{
+    nav_ctx_t *ctx = path->ctx;
+    int start = nav_data.node_clusters[path->start->id];
+    int goal = nav_data.node_clusters[path->goal->id];
+    const float *goal_origin = nav_data.cluster_origins[goal];
+
+    if (start == goal)
+        return false;
+
+    Nav_BeginSearch(ctx);
+    Nav_TouchNode(ctx, start);
+
+    ctx->came_from[start] = INVALID_ID;
+    ctx->g_score[start] = 0;
+    Nav_PushOpenSet(ctx, start, DistanceSquared(nav_data.cluster_origins[start], goal_origin));
+
+    while (ctx->num_open) {
+        int current = Nav_PopOpenSet(ctx);
+
+        if (current == goal) {
+            if (!++ctx->corridor_stamp) {
+                memset(ctx->corridor, 0, sizeof(ctx->corridor[0]) * nav_data.num_nodes);
+                ctx->corridor_stamp = 1;
+            }
+            for (int n = current; n != INVALID_ID; n = ctx->came_from[n])
+                ctx->corridor[n] = ctx->corridor_stamp;
+            return true;
+        }
+
+        for (int i = nav_data.cluster_first_edge[current]; i < nav_data.cluster_first_edge[current + 1]; i++) {
+            const nav_cluster_edge_t *edge = &nav_data.cluster_edges[i];
+
+            Nav_TouchNode(ctx, edge->target);
+
+            float g_score = ctx->g_score[current] + edge->cost;
+
+            if (g_score >= ctx->g_score[edge->target])
+                continue;
+
+            if (!Nav_ClusterEdgeAccessible(path, edge))
+                continue;
+
+            ctx->came_from[edge->target] = current;
+            ctx->g_score[edge->target] = g_score;
+
+            Nav_PushOpenSet(ctx, edge->target, g_score +
+                            DistanceSquared(nav_data.cluster_origins[edge->target], goal_origin));
+        }
+    }
+
+    return false;
+}
+
+static void Nav_BeginNodeSearch(nav_path_t *path)
+{
+    nav_ctx_t *ctx = path->ctx;
+    int start_id = path->start->id;
+
+    Nav_BeginSearch(ctx);
+    Nav_TouchNode(ctx, start_id);
 
     ctx->came_from[start_id] = INVALID_ID;
     ctx->g_score[start_id] = 0;
-    Nav_PushOpenSet(ctx, path->start, Nav_Heuristic(path, path->start));
+    Nav_PushOpenSet(ctx, start_id, Nav_Heuristic(path, path->start));
+}
+
+// begin A* search between path->start and path->goal. if enabled, do
+// a coarse search over clusters first and refine within that corridor.
+static void Nav_StartSearch(nav_path_t *path)
+{
+    path->version = nav_data.version;
+    path->corridor = nav_clusters->integer && Nav_FindCorridor(path);
+    Nav_BeginNodeSearch(path);
+}
+
+// expand up to *budget nodes, returns true once search is finished.
+// context must not be used for other searches in between calls.
+static bool Nav_ContinueSearch(nav_path_t *path, int *budget)
+{
+    PathInfo *info = path->info;
+    nav_ctx_t *ctx = path->ctx;
+    int goal_id = path->goal->id;
 
     while (true) {
-        nav_open_t *cursor = LIST_FIRST(nav_open_t, &ctx->open_set_head, entry);
+        if (!ctx->num_open) {
+            if (!path->corridor)
+                break;
 
-        // end of open set
-        if (LIST_TERM(cursor, &ctx->open_set_head, entry))
-            break;
+            // corridor may be too narrow, search everything
+            path->corridor = false;
+            Nav_BeginNodeSearch(path);
+        }
 
-        // shift off the head, insert into free
-        List_Remove(&cursor->entry);
-        List_Insert(&ctx->open_set_free, &cursor->entry);
+        if (*budget <= 0)
+            return false;
+        (*budget)--;
 
-        int current = cursor->node->id;
+        int current = Nav_PopOpenSet(ctx);
+        nav_data.nodes_expanded++;
 
         if (current == goal_id) {
             Nav_ReachedGoal(path, current);
-            return;
+            return true;
         }
 
         const nav_node_t *current_node = &nav_data.nodes[current];
@@ -754,6 +1949,11 @@ static void Nav_Path(nav_path_t *path)
 
             int target_id = link->target->id;
 
+            if (path->corridor && ctx->corridor[nav_data.node_clusters[target_id]] != ctx->corridor_stamp)
+                continue;
+
+            Nav_TouchNode(ctx, target_id);
+
             float temp_g_score = ctx->g_score[current] + Nav_Weight(path, current_node, link);
 
             if (temp_g_score >= ctx->g_score[target_id])
@@ -762,11 +1962,381 @@ static void Nav_Path(nav_path_t *path)
             ctx->came_from[target_id] = current;
             ctx->g_score[target_id] = temp_g_score;
 
-            Nav_PushOpenSet(ctx, link->target, temp_g_score + Nav_Heuristic(path, link->target));
+            Nav_PushOpenSet(ctx, target_id, temp_g_score + Nav_Heuristic(path, link->target));
         }
     }
 
     info->returnCode = PathReturnCode_NoPathFound;
+    return true;
+}
+
+static void Nav_Search(nav_path_t *path)
+{
+    int budget = INT_MAX;
+
+    Nav_StartSearch(path);
+    Nav_ContinueSearch(path, &budget);
+}
+
+/*
+==============================================================================
+
+NEXT HOP TABLE
+
+For small graphs, next hop from every node to every goal is precomputed
+over the part of the graph that doesn't depend on entity state: walk
+links between nodes that are never disabled and are accessible with any
+walking request. Routes found there are valid for all such requests;
+everything else falls back to A*. Table size is capped by nav_hop_table
+cvar, in kilobytes.
+
+==============================================================================
+*/
+
+#define NAV_HOP_REJECT_FLAGS \
+    (NodeFlag_ConditionalMask | NodeFlag_Disabled | NodeFlag_NoPOI | NodeFlag_NoMonsters | NodeFlag_Crouch | \
+     NodeFlag_Ladder | NodeFlag_Elevator | NodeFlag_Pusher | NodeFlag_Teleporter | NodeFlag_UnderWater)
+
+static bool Nav_HopLinkUsable(const nav_node_t *node, const nav_link_t *link)
+{
+    return link->type == NavLinkType_Walk && !link->edict &&
+        !(node->flags & NAV_HOP_REJECT_FLAGS) && !(link->target->flags & NAV_HOP_REJECT_FLAGS);
+}
+
+// backwards Dijkstra search from one goal, same as Nav_BuildFlow.
+// runs on worker threads, each with its own context.
+static void Nav_HopTableJob(void *arg, int goal_id, int worker)
+{
+    nav_ctx_t *ctx = (nav_ctx_t *)arg + worker;
+    uint16_t *next_hop = &nav_data.next_hop[goal_id * nav_data.num_nodes];
+
+    for (int i = 0; i < nav_data.num_nodes; i++)
+        next_hop[i] = INVALID_ID;
+
+    if (nav_data.nodes[goal_id].flags & NAV_HOP_REJECT_FLAGS)
+        return;
+
+    Nav_BeginSearch(ctx);
+    Nav_TouchNode(ctx, goal_id);
+
+    ctx->g_score[goal_id] = 0;
+    Nav_PushOpenSet(ctx, goal_id, 0);
+
+    while (ctx->num_open) {
+        int current = Nav_PopOpenSet(ctx);
+
+        for (int i = nav_data.in_first[current]; i < nav_data.in_first[current + 1]; i++) {
+            const nav_link_t *link = &nav_data.links[nav_data.in_links[i]];
+            const nav_node_t *node = &nav_data.nodes[nav_data.link_sources[nav_data.in_links[i]]];
+
+            if (!Nav_HopLinkUsable(node, link))
+                continue;
+
+            Nav_TouchNode(ctx, node->id);
+
+            float cost = ctx->g_score[current] + DistanceSquared(node->origin, link->target->origin);
+
+            if (cost >= ctx->g_score[node->id])
+                continue;
+
+            ctx->g_score[node->id] = cost;
+            next_hop[node->id] = current;
+            Nav_PushOpenSet(ctx, node->id, cost);
+        }
+    }
+}
+
+static void Nav_BuildHopTable(void)
+{
+    size_t count = (size_t)nav_data.num_nodes * nav_data.num_nodes;
+    size_t size = sizeof(nav_data.next_hop[0]) * count;
+    int i, num_workers;
+
+    if (!nav_data.nodes || size > nav_hop_table->value * 1024)
+        return;
+
+    nav_data.next_hop = gi.TagMalloc(size, TAG_NAV);
+
+    // contexts must be allocated on main thread
+    num_workers = G_NumWorkers();
+    nav_ctx_t *ctx = gi.TagMalloc(sizeof(ctx[0]) * num_workers, TAG_NAV);
+    ctx[0] = nav_data.ctx;
+    for (i = 1; i < num_workers; i++)
+        Nav_AllocContext(&ctx[i]);
+
+    G_RunJobs(Nav_HopTableJob, ctx, nav_data.num_nodes);
+
+    nav_data.ctx = ctx[0];
+    for (i = 1; i < num_workers; i++)
+        Nav_FreeContext(&ctx[i]);
+    gi.TagFree(ctx);
+
+    gi.dprintf("Built %zu KB next hop table using %d workers\n", size / 1024, num_workers);
+}
+
+// follows next hop table from start to goal, returns false
+// if request must be handled by regular search
+static bool Nav_HopPath(nav_path_t *path)
+{
+    const PathRequest *req = path->request;
+    nav_ctx_t *ctx = path->ctx;
+    int goal_id = path->goal->id;
+    int num_points = 0;
+
+    if (!nav_data.next_hop)
+        return false;
+    if (!req->nodeSearch.ignoreNodeFlags && !(req->pathFlags & PathFlags_Walk))
+        return false;
+
+    const uint16_t *next_hop = &nav_data.next_hop[goal_id * nav_data.num_nodes];
+
+    if (next_hop[path->start->id] == INVALID_ID)
+        return false;
+
+    for (int n = path->start->id; n != goal_id; n = next_hop[n])
+        ctx->went_to[num_points++] = n;
+
+    Nav_FinishPath(path, goal_id, num_points);
+    return true;
+}
+
+/*
+==============================================================================
+
+PATH CACHE
+
+Monsters chasing the same target from the same area tend to end up with
+identical start and goal nodes. Node paths found by A* are kept in a
+small LRU cache and replayed for matching requests. Entries are dropped
+when node flags change and after NAV_PATH_LIFETIME, since link
+accessibility also depends on entity state.
+
+==============================================================================
+*/
+
+static bool Nav_CachedPathMatches(const nav_cached_path_t *c, const nav_path_t *path)
+{
+    const PathRequest *req = path->request;
+
+    return c->valid && c->start == path->start->id && c->goal == path->goal->id &&
+        c->ignore_flags == req->nodeSearch.ignoreNodeFlags &&
+        c->path_flags == req->pathFlags &&
+        c->jump_height == req->traversals.jumpHeight &&
+        c->drop_height == req->traversals.dropHeight;
+}
+
+// finishes path from cache, returns false on cache miss
+static bool Nav_CachedPath(nav_path_t *path)
+{
+    nav_ctx_t *ctx = path->ctx;
+
+    if (!nav_path_cache->integer)
+        return false;
+
+    for (int i = 0; i < NAV_MAX_CACHED_PATHS; i++) {
+        nav_cached_path_t *c = &nav_data.cached_paths[i];
+
+        if (!Nav_CachedPathMatches(c, path))
+            continue;
+        if (c->version != nav_data.version || c->time > level.time || c->time + NAV_PATH_LIFETIME <= level.time)
+            break;
+
+        nav_data.cache_hits++;
+        c->used = level.time;
+
+        if (c->num_points < 0) {
+            path->info->returnCode = PathReturnCode_NoPathFound;
+            return true;
+        }
+
+        memcpy(ctx->went_to, c->points, sizeof(c->points[0]) * c->num_points);
+        Nav_FinishPath(path, c->goal, c->num_points);
+        return true;
+    }
+
+    nav_data.cache_misses++;
+    return false;
+}
+
+// stores result of finished search
+static void Nav_CachePath(const nav_path_t *path)
+{
+    const PathRequest *req = path->request;
+    const nav_ctx_t *ctx = path->ctx;
+    nav_cached_path_t *c = NULL;
+    int num_points = -1;
+
+    if (!nav_path_cache->integer || path->version != nav_data.version)
+        return;
+
+    if (path->info->returnCode != PathReturnCode_NoPathFound) {
+        num_points = path->num_points;
+        if (num_points > NAV_MAX_CACHED_POINTS)
+            return;
+    }
+
+    // replace matching, unused or least recently used entry
+    for (int i = 0; i < NAV_MAX_CACHED_PATHS; i++) {
+        nav_cached_path_t *e = &nav_data.cached_paths[i];
+
+        if (Nav_CachedPathMatches(e, path)) {
+            c = e;
+            break;
+        }
+
+        if (!c || (c->valid && (!e->valid || e->used < c->used)))
+            c = e;
+    }
+
+    c->valid = true;
+    c->start = path->start->id;
+    c->goal = path->goal->id;
+    c->ignore_flags = req->nodeSearch.ignoreNodeFlags;
+    c->path_flags = req->pathFlags;
+    c->jump_height = req->traversals.jumpHeight;
+    c->drop_height = req->traversals.dropHeight;
+    c->version = path->version;
+    c->time = c->used = level.time;
+    c->num_points = num_points;
+    if (num_points > 0)
+        memcpy(c->points, ctx->went_to, sizeof(c->points[0]) * num_points);
+}
+
+static void Nav_Path(nav_path_t *path)
+{
+    if (!Nav_SetupPath(path) || Nav_HopPath(path) || Nav_CachedPath(path))
+        return;
+
+    Nav_Search(path);
+    Nav_CachePath(path);
+}
+
+/*
+==============================================================================
+
+FLOW FIELDS
+
+Instead of searching from each start node, run one Dijkstra search
+backwards from the goal node and remember the next hop of every node.
+Everyone chasing the same target with the same movement capabilities
+then only needs to follow next hops. Fields are rebuilt when node flags
+change and after NAV_FLOW_LIFETIME, since link accessibility also
+depends on entity state.
+
+==============================================================================
+*/
+
+static bool Nav_FlowMatches(const nav_flow_t *flow, const nav_path_t *path)
+{
+    const PathRequest *req = path->request;
+
+    return flow->cost && flow->goal == path->goal->id &&
+        flow->ignore_flags == req->nodeSearch.ignoreNodeFlags &&
+        flow->path_flags == req->pathFlags &&
+        flow->jump_height == req->traversals.jumpHeight &&
+        flow->drop_height == req->traversals.dropHeight;
+}
+
+static void Nav_BuildFlow(nav_path_t *path, nav_flow_t *flow)
+{
+    nav_ctx_t *ctx = path->ctx;
+    int goal_id = path->goal->id;
+
+    for (int i = 0; i < nav_data.num_nodes; i++) {
+        flow->cost[i] = INFINITY;
+        flow->next_hop[i] = INVALID_ID;
+    }
+
+    Nav_BeginSearch(ctx);
+    Nav_TouchNode(ctx, goal_id);
+
+    flow->cost[goal_id] = 0;
+    Nav_PushOpenSet(ctx, goal_id, 0);
+
+    while (ctx->num_open) {
+        int current = Nav_PopOpenSet(ctx);
+        nav_data.nodes_expanded++;
+
+        for (int i = nav_data.in_first[current]; i < nav_data.in_first[current + 1]; i++) {
+            const nav_link_t *link = &nav_data.links[nav_data.in_links[i]];
+            const nav_node_t *node = &nav_data.nodes[nav_data.link_sources[nav_data.in_links[i]]];
+
+            if (!Nav_LinkAccessible(path, node, link))
+                continue;
+
+            float cost = flow->cost[current] + Nav_Weight(path, node, link);
+
+            if (cost >= flow->cost[node->id])
+                continue;
+
+            Nav_TouchNode(ctx, node->id);
+            flow->cost[node->id] = cost;
+            flow->next_hop[node->id] = current;
+            Nav_PushOpenSet(ctx, node->id, cost);
+        }
+    }
+}
+
+static const nav_flow_t *Nav_GetFlow(nav_path_t *path)
+{
+    const PathRequest *req = path->request;
+    nav_flow_t *flow = NULL;
+
+    for (int i = 0; i < NAV_MAX_FLOWS; i++) {
+        nav_flow_t *f = &nav_data.flows[i];
+
+        if (Nav_FlowMatches(f, path)) {
+            flow = f;
+            break;
+        }
+
+        // pick unused or least recently used slot
+        if (!flow || (flow->cost && (!f->cost || f->used < flow->used)))
+            flow = f;
+    }
+
+    flow->used = level.time;
+
+    if (Nav_FlowMatches(flow, path) && flow->version == nav_data.version &&
+        flow->time <= level.time && flow->time + NAV_FLOW_LIFETIME > level.time)
+        return flow;
+
+    if (!flow->cost) {
+        flow->cost = gi.TagMalloc(sizeof(flow->cost[0]) * nav_data.num_nodes, TAG_NAV);
+        flow->next_hop = gi.TagMalloc(sizeof(flow->next_hop[0]) * nav_data.num_nodes, TAG_NAV);
+    }
+
+    flow->goal = path->goal->id;
+    flow->ignore_flags = req->nodeSearch.ignoreNodeFlags;
+    flow->path_flags = req->pathFlags;
+    flow->jump_height = req->traversals.jumpHeight;
+    flow->drop_height = req->traversals.dropHeight;
+    flow->version = nav_data.version;
+    flow->time = level.time;
+
+    Nav_BuildFlow(path, flow);
+    return flow;
+}
+
+static void Nav_FlowPath(nav_path_t *path)
+{
+    if (!Nav_SetupPath(path))
+        return;
+
+    const nav_flow_t *flow = Nav_GetFlow(path);
+    nav_ctx_t *ctx = path->ctx;
+    int goal_id = path->goal->id;
+    int num_points = 0;
+
+    if (flow->cost[path->start->id] == INFINITY) {
+        path->info->returnCode = PathReturnCode_NoPathFound;
+        return;
+    }
+
+    for (int n = path->start->id; n != goal_id; n = flow->next_hop[n])
+        ctx->went_to[num_points++] = n;
+
+    Nav_FinishPath(path, goal_id, num_points);
 }
 
 static void Nav_DebugPath(const PathRequest *request, const PathInfo *path)
@@ -817,6 +2387,285 @@ bool Nav_GetPathToGoal(const PathRequest *request, PathInfo *info)
     return info->returnCode < PathReturnCode_StartPathErrors;
 }
 
+/*
+==============================================================================
+
+TIME-SLICED PATH REQUESTS
+
+Searches are run one at a time in request order on a dedicated context,
+expanding at most nav_search_budget nodes per server frame in total.
+Node lookup is still done at request time.
+
+==============================================================================
+*/
+
+static bool Nav_PendingValid(const nav_pending_t *p)
+{
+    const edict_t *owner = &g_edicts[p->owner];
+
+    if (!p->owner)
+        return false;
+    if (!owner->inuse || owner->spawn_count != p->spawn_count)
+        return false;
+
+    // owner stopped polling for result
+    if (p->finished && p->time < level.time - SEC(1))
+        return false;
+
+    return true;
+}
+
+static nav_pending_t *Nav_FindPending(const edict_t *owner)
+{
+    for (int i = 0; i < NAV_MAX_PENDING; i++) {
+        nav_pending_t *p = &nav_data.pending[i];
+        if (p->owner == owner->s.number && Nav_PendingValid(p))
+            return p;
+    }
+
+    return NULL;
+}
+
+static nav_pending_t *Nav_AllocPending(void)
+{
+    for (int i = 0; i < NAV_MAX_PENDING; i++) {
+        nav_pending_t *p = &nav_data.pending[i];
+        if (!Nav_PendingValid(p))
+            return p;
+    }
+
+    return NULL;
+}
+
+// queues search for owner, or finishes it right away if no search is needed
+static void Nav_StartPending(nav_pending_t *p, const edict_t *owner, const PathRequest *request, uint32_t seq)
+{
+    memset(p, 0, sizeof(*p));
+    p->owner = owner->s.number;
+    p->spawn_count = owner->spawn_count;
+    p->seq = seq;
+    p->request = *request;
+    p->path.request = &p->request;
+    p->path.info = &p->info;
+    p->path.ctx = &nav_data.async_ctx;
+
+    if (!Nav_SetupPath(&p->path) || Nav_HopPath(&p->path) || Nav_CachedPath(&p->path)) {
+        p->finished = true;
+        p->time = level.time;
+    }
+}
+
+static void Nav_RunPending(void)
+{
+    while (nav_data.search_budget > 0) {
+        nav_pending_t *next = NULL;
+
+        for (int i = 0; i < NAV_MAX_PENDING; i++) {
+            nav_pending_t *p = &nav_data.pending[i];
+            if (!Nav_PendingValid(p) || p->finished)
+                continue;
+            if (!next || p->seq < next->seq)
+                next = p;
+        }
+
+        if (!next)
+            break;
+
+        if (!next->started) {
+            Nav_StartSearch(&next->path);
+            next->started = true;
+        }
+
+        if (Nav_ContinueSearch(&next->path, &nav_data.search_budget)) {
+            Nav_CachePath(&next->path);
+            next->finished = true;
+            next->time = level.time;
+        }
+    }
+}
+
+/*
+=============
+Nav_RequestPathToGoal
+
+Time-sliced version of Nav_GetPathToGoal. Returns false if the search
+for owner is still running, leaving info untouched; owner should keep
+following its previous path and call again on a later frame. Otherwise
+stores result in info and returns true. Requests made while a search is
+running for the same owner poll the running search, unless the goal has
+moved too far since, in which case the search is restarted in place.
+
+If nav_flow_fields is set, paths are instead looked up synchronously
+in a flow field shared by everyone heading for the same goal node.
+=============
+*/
+bool Nav_RequestPathToGoal(const edict_t *owner, const PathRequest *request, PathInfo *info)
+{
+    nav_pending_t *p = Nav_FindPending(owner);
+
+    if (!p && nav_flow_fields->integer && !request->pathPoints.count) {
+        nav_path_t path = {
+            .request = request,
+            .info = info,
+            .ctx = &nav_data.ctx,
+        };
+        Nav_FlowPath(&path);
+        if (request->debugging.drawTime > 0)
+            Nav_DebugPath(request, info);
+        return true;
+    }
+
+    if (!p) {
+        // raw path points can't be written back later
+        if (!nav_data.nodes || nav_search_budget->integer <= 0 || request->pathPoints.count ||
+            !(p = Nav_AllocPending())) {
+            Nav_GetPathToGoal(request, info);
+            return true;
+        }
+
+        Nav_StartPending(p, owner, request, nav_data.pending_seq++);
+    } else if (Distance(p->request.goal, request->goal) > NAV_PENDING_GOAL_MOVE) {
+        // result would lead to stale goal; keep place in queue
+        Nav_StartPending(p, owner, request, p->seq);
+    }
+
+    Nav_RunPending();
+
+    if (!p->finished)
+        return false;
+
+    *info = p->info;
+    p->owner = 0;
+
+    if (p->request.debugging.drawTime > 0)
+        Nav_DebugPath(&p->request, info);
+
+    return true;
+}
+
+/*
+=============
+Nav_Benchmark
+
+Times raw node to node searches between pseudo-random node pairs.
+Queries are bucketed by resulting path length. Node lookup isn't
+included, only the search itself.
+=============
+*/
+#define NAV_BENCH_SHORT_PATH    16
+
+void Nav_Benchmark(int count)
+{
+    static const char *const names[] = { "short", "long", "failed" };
+    struct {
+        int     queries;
+        int     points;
+        clock_t time;
+    } stats[3] = { 0 };
+
+    if (!nav_data.nodes || nav_data.num_nodes < 2) {
+        gi.cprintf(NULL, PRINT_HIGH, "No navigation data loaded\n");
+        return;
+    }
+
+    PathRequest request = {
+        .pathFlags = PathFlags_All,
+        .nodeSearch.ignoreNodeFlags = true,
+    };
+    PathInfo info;
+    nav_path_t path = {
+        .request = &request,
+        .info = &info,
+        .ctx = &nav_data.ctx,
+    };
+
+    // fixed seed so results are comparable between runs
+    uint32_t seed = 1;
+
+    for (int i = 0; i < count; i++) {
+        seed = seed * 1664525 + 1013904223;
+        int a = (seed >> 8) % nav_data.num_nodes;
+        seed = seed * 1664525 + 1013904223;
+        int b = (seed >> 8) % nav_data.num_nodes;
+
+        if (a == b)
+            continue;
+
+        path.start = &nav_data.nodes[a];
+        path.goal = &nav_data.nodes[b];
+        VectorCopy(path.start->origin, request.start);
+        VectorCopy(path.goal->origin, request.goal);
+        memset(&info, 0, sizeof(info));
+
+        clock_t start = clock();
+        Nav_Search(&path);
+        clock_t time = clock() - start;
+
+        int bucket;
+        if (info.returnCode == PathReturnCode_NoPathFound)
+            bucket = 2;
+        else if (info.numPathPoints < NAV_BENCH_SHORT_PATH)
+            bucket = 0;
+        else
+            bucket = 1;
+
+        stats[bucket].queries++;
+        stats[bucket].points += info.numPathPoints;
+        stats[bucket].time += time;
+    }
+
+    gi.cprintf(NULL, PRINT_HIGH, "%u nodes, %d queries\n", nav_data.num_nodes, count);
+    for (int i = 0; i < q_countof(stats); i++) {
+        if (!stats[i].queries)
+            continue;
+        gi.cprintf(NULL, PRINT_HIGH, "%-6s: %6d queries, %5.1f avg points, %8.2f usec/query\n",
+                   names[i], stats[i].queries, (double)stats[i].points / stats[i].queries,
+                   stats[i].time * 1e6 / CLOCKS_PER_SEC / stats[i].queries);
+    }
+}
+
+/*
+=============
+Nav_PrintStats
+
+Prints path cache statistics for current level.
+=============
+*/
+void Nav_PrintStats(void)
+{
+    uint32_t total = nav_data.cache_hits + nav_data.cache_misses;
+    int used = 0;
+
+    if (!nav_data.nodes) {
+        gi.cprintf(NULL, PRINT_HIGH, "No navigation data loaded\n");
+        return;
+    }
+
+    for (int i = 0; i < NAV_MAX_CACHED_PATHS; i++)
+        used += nav_data.cached_paths[i].valid;
+
+    gi.cprintf(NULL, PRINT_HIGH, "Path cache: %u hits, %u misses (%.1f%% hit rate), %d/%d entries\n",
+               nav_data.cache_hits, nav_data.cache_misses, total ? nav_data.cache_hits * 100.0 / total : 0.0,
+               used, NAV_MAX_CACHED_PATHS);
+}
+
+void Nav_GetStats(nav_stats_t *stats)
+{
+    stats->num_nodes = nav_data.num_nodes;
+    stats->nodes_expanded = nav_data.nodes_expanded;
+    stats->cache_hits = nav_data.cache_hits;
+    stats->cache_misses = nav_data.cache_misses;
+}
+
+bool Nav_GetNodeOrigin(int id, vec3_t origin)
+{
+    if (id < 0 || id >= nav_data.num_nodes)
+        return false;
+
+    VectorCopy(nav_data.nodes[id].origin, origin);
+    return true;
+}
+
 static void Nav_GetNodeBounds(const nav_node_t *node, vec3_t mins, vec3_t maxs)
 {
     VectorSet(mins, -16, -16, -24);
@@ -1000,8 +2849,20 @@ static void Nav_Debug(void)
 
     draw->ClearDebugLines();
 
-    for (int i = 0; i < nav_data.num_nodes; i++)
-        Nav_DrawNode(&nav_data.nodes[i]);
+    const vec_t *org = g_edicts[1].s.origin;
+    float range = nav_debug_range->value;
+    nav_filter_t filter = {
+        .origin = { org[0], org[1], org[2] },
+        .radius_sq = range * range,
+        .min_z = org[2] - range,
+        .max_z = org[2] + range,
+    };
+
+    nav_candidate_t *cand = nav_data.candidates;
+    int num_cand = Nav_FilterSlots(&filter, 0, nav_data.num_nodes, cand, 0);
+
+    for (int i = 0; i < num_cand; i++)
+        Nav_DrawNode(&nav_data.nodes[cand[i].id]);
 }
 
 static bool line_intersects_box(const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs)
@@ -1060,12 +2921,9 @@ static void Nav_UpdateConditionalNode(nav_node_t *node)
         VectorAdd(origin, mins, absmin);
         VectorAdd(origin, maxs, absmax);
 
-        for (int i = game.maxclients + BODY_QUEUE_SIZE + 1; i < globals.num_edicts; i++) {
-            const edict_t *e = &g_edicts[i];
-
-            if (!e->inuse)
-                continue;
+        const edict_t *e;
 
+        for (int i = 0; (e = G_NextTrap(&i)); ) {
             if (e->flags & FL_TRAP_LASER_FIELD) {
                 if (e->svflags & SVF_NOCLIENT)
                     continue;
@@ -1122,6 +2980,109 @@ static void Nav_UpdateConditionalNode(nav_node_t *node)
     }
 }
 
+// marks conditional nodes whose checks may be affected by
+// something within the given box for update this frame
+static void Nav_MarkDirtyNodes(const vec3_t absmin, const vec3_t absmax)
+{
+    // node check bounds relative to node origin, see
+    // Nav_GetNodeBounds and Nav_GetNodeTraceOrigin
+    const float ofs_xy = 16;
+    const float ofs_down = 24 - NavFloorDistance;
+    const float ofs_up = 24 + 32;
+
+    int x0 = Nav_GridCoord(absmin[0] - ofs_xy, nav_data.grid_origin[0], nav_data.grid_width);
+    int y0 = Nav_GridCoord(absmin[1] - ofs_xy, nav_data.grid_origin[1], nav_data.grid_height);
+    int x1 = Nav_GridCoord(absmax[0] + ofs_xy, nav_data.grid_origin[0], nav_data.grid_width);
+    int y1 = Nav_GridCoord(absmax[1] + ofs_xy, nav_data.grid_origin[1], nav_data.grid_height);
+
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            int cell = y * nav_data.grid_width + x;
+
+            for (int i = nav_data.grid_cells[cell]; i < nav_data.grid_cells[cell + 1]; i++) {
+                const nav_node_t *node = &nav_data.nodes[nav_data.grid_nodes[i]];
+
+                if (!(node->flags & NodeFlag_ConditionalMask))
+                    continue;
+                if (node->origin[0] + ofs_xy < absmin[0] || node->origin[0] - ofs_xy > absmax[0])
+                    continue;
+                if (node->origin[1] + ofs_xy < absmin[1] || node->origin[1] - ofs_xy > absmax[1])
+                    continue;
+                if (node->origin[2] + ofs_up < absmin[2] || node->origin[2] + ofs_down > absmax[2])
+                    continue;
+
+                nav_data.dirty_nodes[node->id] = true;
+            }
+        }
+    }
+}
+
+/*
+=============
+Nav_EntityLinked
+
+Called each time an entity is linked. Brush entities may block or
+unblock nodes as they move.
+=============
+*/
+void Nav_EntityLinked(const edict_t *ent)
+{
+    if (!nav_data.nodes || ent->solid != SOLID_BSP)
+        return;
+
+    Nav_MarkDirtyNodes(ent->absmin, ent->absmax);
+}
+
+static void Nav_UpdateConditionalNodes(void)
+{
+    const edict_t *e;
+    int i;
+
+    // traps are few, but may move without being linked
+    for (i = 0; (e = G_NextTrap(&i)); ) {
+        if (e->flags & FL_TRAP_LASER_FIELD) {
+            vec3_t absmin, absmax;
+            for (int j = 0; j < 3; j++) {
+                absmin[j] = min(e->s.origin[j], e->s.old_origin[j]);
+                absmax[j] = max(e->s.origin[j], e->s.old_origin[j]);
+            }
+            Nav_MarkDirtyNodes(absmin, absmax);
+        } else {
+            Nav_MarkDirtyNodes(e->absmin, e->absmax);
+        }
+    }
+
+    // besides dirty nodes, update disabled nodes every frame since
+    // whatever disabled them may have gone away without notice,
+    // and cycle through the rest in the background
+    uint32_t slice = nav_conditional_slice->integer;
+    uint32_t start = nav_data.next_conditional;
+    uint32_t count = nav_data.num_conditional_nodes;
+
+    if (!slice || slice > count)
+        slice = count;
+
+    for (i = 0; i < count; i++) {
+        nav_node_t *node = nav_data.conditional_nodes[i];
+        nav_node_flags_t old_flags = node->flags;
+
+        if (!(node->flags & NodeFlag_Disabled) && !nav_data.dirty_nodes[node->id] &&
+            (i + count - start) % count >= slice)
+            continue;
+
+        nav_data.dirty_nodes[node->id] = false;
+        Nav_UpdateConditionalNode(node);
+
+        if (node->flags != old_flags) {
+            nav_data.slot_flags[nav_data.node_slots[node->id]] = node->flags;
+            nav_data.version++;
+        }
+    }
+
+    if (count)
+        nav_data.next_conditional = (start + slice) % count;
+}
+
 static void Nav_SetupEntities(void)
 {
     for (int i = 0; i < nav_data.num_edicts; i++) {
@@ -1151,10 +3112,17 @@ void Nav_Frame(void)
     if (!nav_data.setup_entities && level.time >= SEC(1)) {
         Nav_SetupEntities();
         nav_data.setup_entities = true;
+        nav_data.version++;
     }
 
-    for (int i = 0; i < nav_data.num_conditional_nodes; i++)
-        Nav_UpdateConditionalNode(nav_data.conditional_nodes[i]);
+    Nav_UpdateConditionalNodes();
+
+    // node flags may have changed
+    nav_data.num_closest = 0;
+
+    // finish searches queued last frame first
+    nav_data.search_budget = nav_search_budget->integer;
+    Nav_RunPending();
 
     Nav_Debug();
 }
@@ -1164,6 +3132,13 @@ void Nav_Init(void)
     nav_enable = gi.cvar("nav_enable", "1", 0);
     nav_debug = gi.cvar("nav_debug", "0", 0);
     nav_debug_range = gi.cvar("nav_debug_range", "512", 0);
+    nav_search_budget = gi.cvar("nav_search_budget", "2048", 0);
+    nav_flow_fields = gi.cvar("nav_flow_fields", "0", 0);
+    nav_conditional_slice = gi.cvar("nav_conditional_slice", "32", 0);
+    nav_clusters = gi.cvar("nav_clusters", "0", 0);
+    nav_cache = gi.cvar("nav_cache", "1", 0);
+    nav_hop_table = gi.cvar("nav_hop_table", "0", 0);
+    nav_path_cache = gi.cvar("nav_path_cache", "1", 0);
 }
 
 void Nav_Shutdown(void)
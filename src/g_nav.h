@@ -9,6 +9,7 @@ typedef enum {
     PathReturnCode_TraversalPending,        // the upcoming path segment is a traversal
     PathReturnCode_RawPathFound,            // user wanted ( and got ) just a raw path ( no processing )
     PathReturnCode_InProgress,              // pathing in progress
+    PathReturnCode_SearchPending,           // path search not finished yet, try again later
     PathReturnCode_StartPathErrors,         // any code after this one indicates an error of some kind.
     PathReturnCode_InvalidStart,            // start position is invalid.
     PathReturnCode_InvalidGoal,             // goal position is invalid.
@@ -75,6 +76,7 @@ typedef struct {
 } PathInfo;
 
 bool Nav_GetPathToGoal(const PathRequest *request, PathInfo *info);
+bool Nav_RequestPathToGoal(const struct edict_s *owner, const PathRequest *request, PathInfo *info);
 
 // life cycle stuff
 void Nav_Init(void);
@@ -82,3 +84,16 @@ void Nav_Shutdown(void);
 void Nav_Load(const char *mapname);
 void Nav_Unload(void);
 void Nav_Frame(void);
+void Nav_EntityLinked(const struct edict_s *ent);
+
+// debugging
+typedef struct {
+    uint32_t    num_nodes;
+    uint32_t    nodes_expanded;
+    uint32_t    cache_hits, cache_misses;
+} nav_stats_t;
+
+void Nav_Benchmark(int count);
+void Nav_PrintStats(void);
+void Nav_GetStats(nav_stats_t *stats);
+bool Nav_GetNodeOrigin(int id, vec3_t origin);
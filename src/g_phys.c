@@ -106,7 +106,7 @@ bool SV_RunThink(edict_t *ent)
     if (thinktime > level.time)
         return true;
 
-    ent->nextthink = 0;
+    G_SetNextThink(ent, 0);
     if (!ent->think)
         gi.error("NULL ent->think");
     ent->think(ent);
@@ -114,6 +114,238 @@ bool SV_RunThink(edict_t *ent)
     return false;
 }
 
+/*
+==============================================================================
+
+THINK SCHEDULER
+
+Entities that have nothing to do but wait for their next think are put to
+sleep and kept in a binary min-heap keyed on nextthink. Everything else is
+awake and gets visited by G_RunFrame in ascending entity number order, just
+like a full scan of g_edicts would do.
+
+==============================================================================
+*/
+
+static byte     sched_awake[MAX_EDICTS / 8];
+static int      sched_heap[MAX_EDICTS];
+static int      sched_pos[MAX_EDICTS];  // heap index + 1, 0 if not queued
+static gtime_t  sched_time[MAX_EDICTS];
+static int      sched_count;
+
+static void SV_SiftUp(int i)
+{
+    int     num = sched_heap[i];
+    gtime_t time = sched_time[num];
+
+    while (i > 0) {
+        int parent = (i - 1) >> 1;
+        int p = sched_heap[parent];
+        if (sched_time[p] <= time)
+            break;
+        sched_heap[i] = p;
+        sched_pos[p] = i + 1;
+        i = parent;
+    }
+
+    sched_heap[i] = num;
+    sched_pos[num] = i + 1;
+}
+
+static void SV_SiftDown(int i)
+{
+    int     num = sched_heap[i];
+    gtime_t time = sched_time[num];
+
+    while (1) {
+        int child = i * 2 + 1;
+        if (child >= sched_count)
+            break;
+        if (child + 1 < sched_count && sched_time[sched_heap[child + 1]] < sched_time[sched_heap[child]])
+            child++;
+        int c = sched_heap[child];
+        if (sched_time[c] >= time)
+            break;
+        sched_heap[i] = c;
+        sched_pos[c] = i + 1;
+        i = child;
+    }
+
+    sched_heap[i] = num;
+    sched_pos[num] = i + 1;
+}
+
+static void SV_QueueThink(int num, gtime_t time)
+{
+    int i = sched_pos[num] - 1;
+
+    if (i < 0) {
+        i = sched_count++;
+        sched_heap[i] = num;
+        sched_time[num] = time;
+        SV_SiftUp(i);
+    } else if (time < sched_time[num]) {
+        sched_time[num] = time;
+        SV_SiftUp(i);
+    } else if (time > sched_time[num]) {
+        sched_time[num] = time;
+        SV_SiftDown(i);
+    }
+}
+
+static void SV_DequeueThink(int num)
+{
+    int i = sched_pos[num] - 1;
+
+    if (i < 0)
+        return;
+
+    sched_pos[num] = 0;
+    if (i == --sched_count)
+        return;
+
+    int last = sched_heap[sched_count];
+    sched_heap[i] = last;
+    if (i > 0 && sched_time[last] < sched_time[sched_heap[(i - 1) >> 1]])
+        SV_SiftUp(i);
+    else
+        SV_SiftDown(i);
+}
+
+/*
+=============
+G_ClearThinkQueue
+
+Called when all edicts are wiped. Clients and the world are always awake.
+=============
+*/
+void G_ClearThinkQueue(void)
+{
+    memset(sched_awake, 0, sizeof(sched_awake));
+    memset(sched_pos, 0, sizeof(sched_pos));
+    sched_count = 0;
+
+    for (int i = 0; i <= game.maxclients; i++)
+        Q_SetBit(sched_awake, i);
+}
+
+/*
+=============
+G_WakeEntity
+
+Makes sure entity is visited by G_RunFrame. If the frame is already
+running and entity number is past the current one, it is visited during
+this frame, otherwise during the next one.
+=============
+*/
+void G_WakeEntity(edict_t *ent)
+{
+    int num = ent - g_edicts;
+
+    Q_SetBit(sched_awake, num);
+    SV_DequeueThink(num);
+}
+
+/*
+=============
+G_SetNextThink
+
+All writes to nextthink must go through here, so that sleeping entities
+can be requeued.
+=============
+*/
+void G_SetNextThink(edict_t *ent, gtime_t nextthink)
+{
+    int num = ent - g_edicts;
+
+    ent->nextthink = nextthink;
+
+    // awake entities will pick it up when they are visited
+    if (Q_IsBitSet(sched_awake, num))
+        return;
+
+    if (nextthink <= 0)
+        SV_DequeueThink(num);
+    else if (nextthink <= level.time)
+        G_WakeEntity(ent);
+    else
+        SV_QueueThink(num, nextthink);
+}
+
+/*
+=============
+G_CheckSleep
+
+Called after entity has been visited or freed. Puts it to sleep if the
+only thing a visit would do is checking for nextthink.
+=============
+*/
+void G_CheckSleep(edict_t *ent)
+{
+    int num = ent - g_edicts;
+
+    if (num <= game.maxclients)
+        return;
+
+    if (!ent->inuse) {
+        Q_ClearBit(sched_awake, num);
+        SV_DequeueThink(num);
+        return;
+    }
+
+    if (ent->movetype != MOVETYPE_NONE || ent->prethink || ent->postthink)
+        return;
+    if (ent->bmodel_anim.enabled || ent->groundentity)
+        return;
+    if (!(ent->s.renderfx & RF_BEAM) && !VectorCompare(ent->s.origin, ent->s.old_origin))
+        return;
+
+    Q_ClearBit(sched_awake, num);
+
+    if (ent->nextthink > 0)
+        SV_QueueThink(num, ent->nextthink);
+    else
+        SV_DequeueThink(num);
+}
+
+/*
+=============
+G_RunThinkQueue
+
+Wakes up all sleeping entities whose think is due this frame.
+=============
+*/
+void G_RunThinkQueue(void)
+{
+    while (sched_count && sched_time[sched_heap[0]] <= level.time) {
+        int num = sched_heap[0];
+        SV_DequeueThink(num);
+        Q_SetBit(sched_awake, num);
+    }
+}
+
+/*
+=============
+G_NextAwakeEntity
+
+Returns number of the first awake entity starting at num, or
+globals.num_edicts if there are none left.
+=============
+*/
+int G_NextAwakeEntity(int num)
+{
+    for (; num < globals.num_edicts; num++) {
+        if (!sched_awake[num >> 3]) {
+            num |= 7;
+            continue;
+        }
+        if (Q_IsBitSet(sched_awake, num))
+            return num;
+    }
+
+    return globals.num_edicts;
+}
+
 /*
 ==================
 G_Impact
@@ -128,8 +360,10 @@ void G_Impact(edict_t *e1, const trace_t *trace)
     if (e1->touch && (e1->solid != SOLID_NOT || (e1->flags & FL_ALWAYS_TOUCH)))
         e1->touch(e1, e2, trace, false);
 
-    if (e2->touch && (e2->solid != SOLID_NOT || (e2->flags & FL_ALWAYS_TOUCH)))
+    if (e2->touch && (e2->solid != SOLID_NOT || (e2->flags & FL_ALWAYS_TOUCH))) {
+        G_WakeEntity(e2);
         e2->touch(e2, e1, trace, true);
+    }
 }
 
 /*
@@ -22,6 +22,10 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #define SAVE_MAGIC1     "SSV2"
 #define SAVE_MAGIC2     "SAV2"
 
+#define SAVE_MAGIC1_BIN "SSVB"
+#define SAVE_MAGIC2_BIN "SAVB"
+#define SAVE_MAGIC2_DELTA "SAVD"
+
 #define SAVE_VERSION_MINIMUM            1
 #define SAVE_VERSION_PLAYERSTATE_EXT    2
 #define SAVE_VERSION_PSX                3
@@ -29,15 +33,11 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #if USE_ZLIB
 #include <zlib.h>
-#ifdef __GNUC__
-int gzprintf(gzFile, const char *, ...) q_printf(2, 3);
-#endif
 #else
 #define gzopen(name, mode)          fopen(name, mode)
 #define gzclose(file)               fclose(file)
-#define gzprintf(file, ...)         fprintf(file, __VA_ARGS__)
-#define gzgets(file, buf, size)     fgets(buf, size, file)
-#define gzbuffer(file, size)        (void)0
+#define gzread(file, buf, len)      (int)fread(buf, 1, len, file)
+#define gzwrite(file, buf, len)     fwrite(buf, 1, len, file)
 #define gzFile                      FILE *
 #endif
 
@@ -741,10 +741,270 @@ static const save_field_t gamefields[] = {
 #undef _OFS
 };
 
+typedef enum {
+    ST_GAME,
+    ST_CLIENT,
+    ST_CLIENT_PERSISTENT,
+    ST_LEVEL,
+    ST_LEVEL_ENTRY,
+    ST_ENTITY,
+    ST_MOVEINFO,
+    ST_MONSTERINFO,
+    ST_REINFORCEMENT,
+    ST_BMODEL_ANIM,
+    ST_PLAYER_FOG,
+    ST_PLAYER_HEIGHTFOG,
+
+    ST_TOTAL
+} save_table_t;
+
+static const struct {
+    const save_field_t *fields;
+    int count;
+} save_tables[ST_TOTAL] = {
+#define TABLE(id, fields)   [id] = { fields, q_countof(fields) }
+    TABLE(ST_GAME, gamefields),
+    TABLE(ST_CLIENT, clientfields),
+    TABLE(ST_CLIENT_PERSISTENT, client_persistent_fields),
+    TABLE(ST_LEVEL, levelfields),
+    TABLE(ST_LEVEL_ENTRY, level_entry_fields),
+    TABLE(ST_ENTITY, entityfields),
+    TABLE(ST_MOVEINFO, moveinfo_fields),
+    TABLE(ST_MONSTERINFO, monsterinfo_fields),
+    TABLE(ST_REINFORCEMENT, reinforcement_fields),
+    TABLE(ST_BMODEL_ANIM, bmodel_anim_fields),
+    TABLE(ST_PLAYER_FOG, player_fog_fields),
+    TABLE(ST_PLAYER_HEIGHTFOG, player_heightfog_fields),
+#undef TABLE
+};
+
+static name_hash_t save_hashes[ST_TOTAL];
+
+// maps function pointers back to save_ptrs entries
+#define PTR_HASH_BITS   13
+#define PTR_HASH_SIZE   (1 << PTR_HASH_BITS)
+
+static uint32_t ptr_hash[PTR_HASH_SIZE];    // (type << 16 | index) + 1, 0 if empty
+
+static unsigned ptr_hash_key(const void *p, ptr_type_t type)
+{
+    uint64_t v = ((uint64_t)(uintptr_t)p ^ type) * UINT64_C(0x9e3779b97f4a7c15);
+    return v >> (64 - PTR_HASH_BITS);
+}
+
+// returns table of nested field type, or -1 if type is not nested
+static int nested_table(int type)
+{
+    switch (type) {
+    case F_CLIENT_PERSISTENT:   return ST_CLIENT_PERSISTENT;
+    case F_MOVEINFO:            return ST_MOVEINFO;
+    case F_MONSTERINFO:         return ST_MONSTERINFO;
+    case F_BMODEL_ANIM:         return ST_BMODEL_ANIM;
+    case F_PLAYER_FOG:          return ST_PLAYER_FOG;
+    case F_PLAYER_HEIGHTFOG:    return ST_PLAYER_HEIGHTFOG;
+    default:                    return -1;
+    }
+}
+
+/*
+============
+G_InitSaveFields
+
+Builds field name hashes for loading savegames, and pointer hash
+for writing them.
+============
+*/
+void G_InitSaveFields(void)
+{
+    static uint16_t slots[4096];
+    int total = 0;
+
+    memset(ptr_hash, 0, sizeof(ptr_hash));
+    for (int type = 0; type < P_num_types; type++) {
+        Q_assert(num_save_ptrs[type] <= UINT16_MAX);
+        for (int i = 0; i < num_save_ptrs[type]; i++) {
+            unsigned j = ptr_hash_key(save_ptrs[type][i].ptr, type);
+            Q_assert(++total <= PTR_HASH_SIZE / 2);
+            while (ptr_hash[j])
+                j = (j + 1) & (PTR_HASH_SIZE - 1);
+            ptr_hash[j] = (type << 16 | i) + 1;
+        }
+    }
+
+    total = 0;
+
+    for (int i = 0; i < ST_TOTAL; i++) {
+        int num_slots = 16;
+        while (num_slots < save_tables[i].count * 2)
+            num_slots <<= 1;
+        Q_assert(total + num_slots <= q_countof(slots));
+        G_InitNameHash(&save_hashes[i], slots + total, num_slots, save_tables[i].fields,
+                       sizeof(save_field_t), q_offsetof(save_field_t, name), save_tables[i].count);
+        total += num_slots;
+    }
+}
+
 //=========================================================
 
 static gzFile fp;
 
+//
+// output
+//
+
+typedef struct {
+    byte    *data;
+    size_t  size;
+    size_t  maxsize;
+} save_buffer_t;
+
+// makes room for len more bytes in buffer
+static void buf_reserve(save_buffer_t *buf, size_t len)
+{
+    if (buf->size + len > buf->maxsize) {
+        size_t maxsize = max(buf->maxsize * 2, buf->size + len + 0x10000);
+        byte *data = gi.TagMalloc(maxsize, TAG_SAVE);
+        if (buf->data) {
+            memcpy(data, buf->data, buf->size);
+            gi.TagFree(buf->data);
+        }
+        buf->data = data;
+        buf->maxsize = maxsize;
+    }
+}
+
+// reserves len bytes at the end of buffer
+static byte *buf_alloc(save_buffer_t *buf, size_t len)
+{
+    byte *p;
+
+    buf_reserve(buf, len);
+    p = buf->data + buf->size;
+    buf->size += len;
+    return p;
+}
+
+static void buf_free(save_buffer_t *buf)
+{
+    if (buf->data)
+        gi.TagFree(buf->data);
+    memset(buf, 0, sizeof(*buf));
+}
+
+/*
+Savegames are serialized into memory first. Compressing and writing them out
+is done by save jobs, on background thread if g_async_saves is set. Jobs
+write into temporary file and rename it over the savegame when done, so the
+old savegame is never left half written.
+
+Server copies the save directory after WriteGame returns, so WriteGame waits
+for all pending jobs. Only WriteLevel returns early, letting the server load
+next map while previous one is being written. Reading functions wait for
+pending jobs before opening any files.
+*/
+
+#define MAX_SAVE_JOBS   4
+
+typedef struct {
+    char            filename[MAX_OSPATH];
+    const char      *mode;
+    save_buffer_t   chunks[3];
+    bool            failed;
+} save_job_t;
+
+static save_job_t   *save_jobs[MAX_SAVE_JOBS];
+static int          num_save_jobs;
+
+// runs on background thread, must not call game imports
+static void save_write_job(void *arg, int index, int worker)
+{
+    save_job_t *job = arg;
+    char tempname[MAX_OSPATH + 4];
+    gzFile f;
+    bool ok;
+
+    Q_snprintf(tempname, sizeof(tempname), "%s.tmp", job->filename);
+
+    f = gzopen(tempname, job->mode);
+    if (!f) {
+        job->failed = true;
+        return;
+    }
+
+    ok = true;
+    for (int i = 0; i < q_countof(job->chunks); i++)
+        if (job->chunks[i].size)
+            ok &= gzwrite(f, job->chunks[i].data, job->chunks[i].size) == job->chunks[i].size;
+    ok &= !gzclose(f);
+
+    if (ok) {
+#ifdef _WIN32
+        // rename doesn't replace existing files on Windows
+        remove(job->filename);
+#endif
+        ok = !rename(tempname, job->filename);
+    }
+
+    if (!ok)
+        remove(tempname);
+
+    job->failed = !ok;
+}
+
+// waits for pending save jobs and frees them
+static void wait_saves(bool fatal)
+{
+    char failed[MAX_OSPATH];
+
+    if (!num_save_jobs)
+        return;
+
+    G_WaitBackground();
+
+    failed[0] = 0;
+    for (int i = 0; i < num_save_jobs; i++) {
+        save_job_t *job = save_jobs[i];
+        if (job->failed) {
+            if (!fatal)
+                gi.dprintf("WARNING: Couldn't write %s\n", job->filename);
+            Q_strlcpy(failed, job->filename, sizeof(failed));
+        }
+        for (int j = 0; j < q_countof(job->chunks); j++)
+            buf_free(&job->chunks[j]);
+        gi.TagFree(job);
+    }
+    num_save_jobs = 0;
+
+    if (fatal && failed[0])
+        gi.error("Couldn't write %s", failed);
+}
+
+// takes ownership of chunk buffers
+static void queue_save(const char *filename, const char *mode, save_buffer_t *chunks, int num_chunks)
+{
+    save_job_t *job;
+
+    if (num_save_jobs == MAX_SAVE_JOBS)
+        wait_saves(true);
+
+    job = gi.TagMalloc(sizeof(*job), TAG_SAVE);
+    if (Q_strlcpy(job->filename, filename, sizeof(job->filename)) >= sizeof(job->filename))
+        gi.error("Oversize filename: %s", filename);
+    job->mode = mode;
+    for (int i = 0; i < num_chunks; i++) {
+        job->chunks[i] = chunks[i];
+        memset(&chunks[i], 0, sizeof(chunks[i]));
+    }
+    save_jobs[num_save_jobs++] = job;
+
+    if (g_async_saves->integer) {
+        G_RunBackground(save_write_job, job);
+    } else {
+        save_write_job(job, 0, 0);
+        wait_saves(true);
+    }
+}
+
 //
 // writing
 //
@@ -765,70 +1025,96 @@ static struct {
     int indent;
 } block;
 
+static save_buffer_t text;
+
+q_printf(1, 2)
+static void text_printf(const char *fmt, ...)
+{
+    va_list argptr;
+    size_t avail;
+    int len;
+
+    buf_reserve(&text, MAX_STRING_CHARS);
+    avail = text.maxsize - text.size;
+
+    va_start(argptr, fmt);
+    len = vsnprintf((char *)text.data + text.size, avail, fmt, argptr);
+    va_end(argptr);
+
+    if (len >= avail) {
+        buf_reserve(&text, len + 1);
+        va_start(argptr, fmt);
+        vsnprintf((char *)text.data + text.size, len + 1, fmt, argptr);
+        va_end(argptr);
+    }
+
+    text.size += len;
+}
+
 #define indent(s)   (int)(block.indent * 2 + strlen(s)), s
 
 static void begin_block(const char *name)
 {
-    gzprintf(fp, "%*s {\n", indent(name));
+    text_printf("%*s {\n", indent(name));
     block.indent++;
 }
 
 static void end_block(void)
 {
     block.indent--;
-    gzprintf(fp, "%*s}\n", indent(""));
+    text_printf("%*s}\n", indent(""));
 }
 
 static void write_tok(const char *name, const char *tok)
 {
-    gzprintf(fp, "%*s %s\n", indent(name), tok);
+    text_printf("%*s %s\n", indent(name), tok);
 }
 
 static void write_int(const char *name, int v)
 {
-    gzprintf(fp, "%*s %d\n", indent(name), v);
+    text_printf("%*s %d\n", indent(name), v);
 }
 
 static void write_uint_hex(const char *name, unsigned v)
 {
     if (v < 256)
-        gzprintf(fp, "%*s %u\n", indent(name), v);
+        text_printf("%*s %u\n", indent(name), v);
     else
-        gzprintf(fp, "%*s %#x\n", indent(name), v);
+        text_printf("%*s %#x\n", indent(name), v);
 }
 
 static void write_int64(const char *name, int64_t v)
 {
-    gzprintf(fp, "%*s %"PRId64"\n", indent(name), v);
+    text_printf("%*s %"PRId64"\n", indent(name), v);
 }
 
 static void write_uint64_hex(const char *name, uint64_t v)
 {
-    gzprintf(fp, "%*s %#"PRIx64"\n", indent(name), v);
+    text_printf("%*s %#"PRIx64"\n", indent(name), v);
 }
 
 static void write_short_v(const char *name, const int16_t *v, int n)
 {
-    gzprintf(fp, "%*s ", indent(name));
+    text_printf("%*s ", indent(name));
     for (int i = 0; i < n; i++)
-        gzprintf(fp, "%d ", v[i]);
-    gzprintf(fp, "\n");
+        text_printf("%d ", v[i]);
+    text_printf("\n");
 }
 
 static void write_int_v(const char *name, const int *v, int n)
 {
-    gzprintf(fp, "%*s ", indent(name));
+    text_printf("%*s ", indent(name));
     for (int i = 0; i < n; i++)
-        gzprintf(fp, "%d ", v[i]);
-    gzprintf(fp, "\n");
+        text_printf("%d ", v[i]);
+    text_printf("\n");
 }
 
 static void write_float_v(const char *name, const float *v, int n)
 {
-    gzprintf(fp, "%*s ", indent(name));
+    text_printf("%*s ", indent(name));
     for (int i = 0; i < n; i++)
-        gzprintf(fp, "%.6g ", v[i]);
-    gzprintf(fp, "\n");
+        text_printf("%.6g ", v[i]);
+    text_printf("\n");
 }
 
 static void write_string(const char *name, const char *s)
@@ -836,7 +1122,7 @@ static void write_string(const char *name, const char *s)
     char buffer[MAX_STRING_CHARS * 4];
 
     COM_EscapeString(buffer, s, sizeof(buffer));
-    gzprintf(fp, "%*s \"%s\"\n", indent(name), buffer);
+    text_printf("%*s \"%s\"\n", indent(name), buffer);
 }
 
 static void write_byte_v(const char *name, const byte *p, int n)
@@ -846,27 +1132,28 @@ static void write_byte_v(const char *name, const byte *p, int n)
         return;
     }
 
-    gzprintf(fp, "%*s ", indent(name));
+    text_printf("%*s ", indent(name));
     for (int i = 0; i < n; i++)
-        gzprintf(fp, "%02x", p[i]);
-    gzprintf(fp, "\n");
+        text_printf("%02x", p[i]);
+    text_printf("\n");
 }
 
 static void write_vector(const char *name, const vec_t *v)
 {
-    gzprintf(fp, "%*s %.6g %.6g %.6g\n", indent(name), v[0], v[1], v[2]);
+    text_printf("%*s %.6g %.6g %.6g\n", indent(name), v[0], v[1], v[2]);
 }
 
-static void write_pointer(const char *name, const void *p, ptr_type_t type)
+static const char *pointer_name(const void *p, ptr_type_t type)
 {
-    const save_ptr_t *ptr;
-    int i;
+    uint32_t v;
 
-    for (i = 0, ptr = save_ptrs[type]; i < num_save_ptrs[type]; i++, ptr++) {
-        if (ptr->ptr == p) {
-            write_tok(name, ptr->name);
-            return;
-        }
+    for (unsigned j = ptr_hash_key(p, type); (v = ptr_hash[j]); j = (j + 1) & (PTR_HASH_SIZE - 1)) {
+        v--;
+        if (v >> 16 != type)
+            continue;
+        const save_ptr_t *ptr = &save_ptrs[type][v & 0xffff];
+        if (ptr->ptr == p)
+            return ptr->name;
     }
 
     gi.error("unknown pointer of type %d: %p", type, p);
@@ -904,16 +1191,8 @@ static const struct {
 
 static void write_stats(const int16_t *stats)
 {
-    int i;
-
-    for (i = 0; i < q_countof(statdefs); i++)
-        if (stats[statdefs[i].stat])
-            break;
-    if (i == q_countof(statdefs))
-        return;
-
     begin_block("ps.stats");
-    for (i = 0; i < q_countof(statdefs); i++)
+    for (int i = 0; i < q_countof(statdefs); i++)
         if (stats[statdefs[i].stat])
             write_int(statdefs[i].name, stats[statdefs[i].stat]);
     end_block();
@@ -923,9 +1202,6 @@ static void write_fields(const char *name, const save_field_t *fields, int count
 
 static void write_reinforcements(const reinforcement_list_t *list)
 {
-    if (!list->num_reinforcements)
-        return;
-
     begin_block(va("reinforcements %d", list->num_reinforcements));
     for (int i = 0; i < list->num_reinforcements; i++)
         write_fields(va("%d", i), reinforcement_fields, q_countof(reinforcement_fields), &list->reinforcements[i]);
@@ -934,9 +1210,6 @@ static void write_reinforcements(const reinforcement_list_t *list)
 
 static void write_level_entries(const level_entry_t *entries)
 {
-    if (!memcmp(entries, &empty.level_entries, sizeof(empty.level_entries)))
-        return;
-
     begin_block("level_entries");
     for (int i = 0; i < MAX_LEVELS_PER_UNIT; i++)
         if (memcmp(&entries[i], &empty.level_entries[0], sizeof(empty.level_entries[0])))
@@ -946,94 +1219,205 @@ static void write_level_entries(const level_entry_t *entries)
 
 static const vec3_t default_gravity = { 0, 0, -1 };
 
+static bool stats_empty(const int16_t *stats)
+{
+    for (int i = 0; i < q_countof(statdefs); i++)
+        if (stats[statdefs[i].stat])
+            return false;
+    return true;
+}
+
+// returns true if field has default value and needs not be saved
+static bool field_empty(const save_field_t *field, const void *p)
+{
+    switch (field->type) {
+    case F_BYTE:
+        return !memcmp(p, &empty, field->size);
+    case F_SHORT:
+        return !memcmp(p, &empty, field->size * sizeof(int16_t));
+    case F_INT:
+        return !memcmp(p, &empty, field->size * sizeof(int));
+    case F_UINT:
+        return !*(unsigned *)p;
+    case F_INT64:
+        return !*(int64_t *)p;
+    case F_UINT64:
+        return !*(uint64_t *)p;
+    case F_BOOL:
+        return !*(bool *)p;
+    case F_FLOAT:
+        return !memcmp(p, &empty, field->size * sizeof(float));
+    case F_GRAVITY:
+        return !((field->size == 1 && *(float *)p != 1.0f) ||
+                 (field->size == 3 && !VectorCompare((float *)p, default_gravity)));
+    case F_VECTOR:
+        return !memcmp(p, &empty, sizeof(vec3_t));
+
+    case F_ZSTRING:
+        return !*(const char *)p;
+    case F_LSTRING:
+    case F_GSTRING:
+    case F_EDICT:
+    case F_CLIENT:
+    case F_ITEM:
+    case F_POINTER:
+        return !*(void **)p;
+
+    case F_CLIENT_PERSISTENT:
+        return !memcmp(p, &empty.client_pers, sizeof(empty.client_pers));
+    case F_INVENTORY:
+        return !memcmp(p, empty.inventory, sizeof(empty.inventory));
+    case F_MAX_AMMO:
+        return !memcmp(p, empty.max_ammo, sizeof(empty.max_ammo));
+    case F_STATS:
+        return stats_empty(p);
+    case F_MOVEINFO:
+        return !memcmp(p, &empty.moveinfo, sizeof(empty.moveinfo));
+    case F_MONSTERINFO:
+        return !memcmp(p, &empty.monsterinfo, sizeof(empty.monsterinfo));
+    case F_REINFORCEMENTS:
+        return !((const reinforcement_list_t *)p)->num_reinforcements;
+    case F_BMODEL_ANIM:
+        return !memcmp(p, &empty.bmodel_anim, sizeof(empty.bmodel_anim));
+    case F_PLAYER_FOG:
+        return !memcmp(p, &empty.player_fog, sizeof(empty.player_fog));
+    case F_PLAYER_HEIGHTFOG:
+        return !memcmp(p, &empty.player_heightfog, sizeof(empty.player_heightfog));
+    case F_LEVEL_ENTRY:
+        return !memcmp(p, empty.level_entries, sizeof(empty.level_entries));
+    }
+
+    return true;
+}
+
+// returns size of field value in memory
+static size_t field_size(const save_field_t *field)
+{
+    switch (field->type) {
+    case F_BYTE:
+    case F_ZSTRING:
+        return field->size;
+    case F_SHORT:
+        return field->size * sizeof(int16_t);
+    case F_INT:
+        return field->size * sizeof(int);
+    case F_FLOAT:
+    case F_GRAVITY:
+        return field->size * sizeof(float);
+    case F_UINT:
+        return sizeof(unsigned);
+    case F_INT64:
+    case F_UINT64:
+        return sizeof(uint64_t);
+    case F_BOOL:
+        return sizeof(bool);
+    case F_VECTOR:
+        return sizeof(vec3_t);
+
+    case F_LSTRING:
+    case F_GSTRING:
+    case F_EDICT:
+    case F_CLIENT:
+    case F_ITEM:
+    case F_POINTER:
+        return sizeof(void *);
+
+    case F_CLIENT_PERSISTENT:
+        return sizeof(empty.client_pers);
+    case F_INVENTORY:
+        return sizeof(empty.inventory);
+    case F_MAX_AMMO:
+        return sizeof(empty.max_ammo);
+    case F_STATS:
+        return sizeof(int16_t) * MAX_STATS;
+    case F_MOVEINFO:
+        return sizeof(empty.moveinfo);
+    case F_MONSTERINFO:
+        return sizeof(empty.monsterinfo);
+    case F_REINFORCEMENTS:
+        return sizeof(reinforcement_list_t);
+    case F_BMODEL_ANIM:
+        return sizeof(empty.bmodel_anim);
+    case F_PLAYER_FOG:
+        return sizeof(empty.player_fog);
+    case F_PLAYER_HEIGHTFOG:
+        return sizeof(empty.player_heightfog);
+    case F_LEVEL_ENTRY:
+        return sizeof(empty.level_entries);
+    }
+
+    return 0;
+}
+
 static void write_field(const save_field_t *field, const void *base)
 {
     const void *p = (const byte *)base + field->ofs;
 
+    if (field_empty(field, p))
+        return;
+
     switch (field->type) {
     case F_BYTE:
-        if (memcmp(p, &empty, field->size))
-            write_byte_v(field->name, p, field->size);
+        write_byte_v(field->name, p, field->size);
         break;
     case F_SHORT:
-        if (memcmp(p, &empty, field->size * sizeof(int16_t)))
-            write_short_v(field->name, p, field->size);
+        write_short_v(field->name, p, field->size);
         break;
     case F_INT:
-        if (memcmp(p, &empty, field->size * sizeof(int)))
-            write_int_v(field->name, p, field->size);
+        write_int_v(field->name, p, field->size);
         break;
     case F_UINT:
-        if (*(unsigned *)p)
-            write_uint_hex(field->name, *(unsigned *)p);
+        write_uint_hex(field->name, *(unsigned *)p);
         break;
     case F_INT64:
-        if (*(int64_t *)p)
-            write_int64(field->name, *(int64_t *)p);
+        write_int64(field->name, *(int64_t *)p);
         break;
     case F_UINT64:
-        if (*(uint64_t *)p)
-            write_uint64_hex(field->name, *(uint64_t *)p);
+        write_uint64_hex(field->name, *(uint64_t *)p);
         break;
     case F_BOOL:
-        if (*(bool *)p)
-            gzprintf(fp, "%*s\n", indent(field->name));
+        text_printf("%*s\n", indent(field->name));
         break;
     case F_FLOAT:
-        if (memcmp(p, &empty, field->size * sizeof(float)))
-            write_float_v(field->name, p, field->size);
-        break;
     case F_GRAVITY:
-        if ((field->size == 1 && *(float *)p != 1.0f) ||
-            (field->size == 3 && !VectorCompare((float *)p, default_gravity)))
-            write_float_v(field->name, p, field->size);
+        write_float_v(field->name, p, field->size);
         break;
     case F_VECTOR:
-        if (memcmp(p, &empty, sizeof(vec3_t)))
-            write_vector(field->name, p);
+        write_vector(field->name, p);
         break;
 
     case F_ZSTRING:
-        if (*(const char *)p)
-            write_string(field->name, (const char *)p);
+        write_string(field->name, (const char *)p);
         break;
     case F_LSTRING:
     case F_GSTRING:
-        if (*(char **)p)
-            write_string(field->name, *(char **)p);
+        write_string(field->name, *(char **)p);
         break;
 
     case F_EDICT:
-        if (*(edict_t **)p)
-            write_int(field->name, *(edict_t **)p - g_edicts);
+        write_int(field->name, *(edict_t **)p - g_edicts);
         break;
     case F_CLIENT:
-        if (*(gclient_t **)p)
-            write_int(field->name, *(gclient_t **)p - game.clients);
+        write_int(field->name, *(gclient_t **)p - game.clients);
         break;
 
     case F_ITEM:
-        if (*(gitem_t **)p)
-            write_tok(field->name, (*(gitem_t **)p)->classname);
+        write_tok(field->name, (*(gitem_t **)p)->classname);
         break;
     case F_POINTER:
-        if (*(void **)p)
-            write_pointer(field->name, *(void **)p, field->size);
+        write_tok(field->name, pointer_name(*(void **)p, field->size));
         break;
 
     case F_CLIENT_PERSISTENT:
-        if (memcmp(p, &empty.client_pers, sizeof(empty.client_pers)))
-            write_fields(field->name, client_persistent_fields, q_countof(client_persistent_fields), p);
+        write_fields(field->name, client_persistent_fields, q_countof(client_persistent_fields), p);
         break;
 
     case F_INVENTORY:
-        if (memcmp(p, empty.inventory, sizeof(empty.inventory)))
-            write_inventory(p);
+        write_inventory(p);
         break;
 
     case F_MAX_AMMO:
-        if (memcmp(p, empty.max_ammo, sizeof(empty.max_ammo)))
-            write_max_ammo(p);
+        write_max_ammo(p);
         break;
 
     case F_STATS:
@@ -1041,13 +1425,11 @@ static void write_field(const save_field_t *field, const void *base)
         break;
 
     case F_MOVEINFO:
-        if (memcmp(p, &empty.moveinfo, sizeof(empty.moveinfo)))
-            write_fields(field->name, moveinfo_fields, q_countof(moveinfo_fields), p);
+        write_fields(field->name, moveinfo_fields, q_countof(moveinfo_fields), p);
         break;
 
     case F_MONSTERINFO:
-        if (memcmp(p, &empty.monsterinfo, sizeof(empty.monsterinfo)))
-            write_fields(field->name, monsterinfo_fields, q_countof(monsterinfo_fields), p);
+        write_fields(field->name, monsterinfo_fields, q_countof(monsterinfo_fields), p);
         break;
 
     case F_REINFORCEMENTS:
@@ -1055,18 +1437,15 @@ static void write_field(const save_field_t *field, const void *base)
         break;
 
     case F_BMODEL_ANIM:
-        if (memcmp(p, &empty.bmodel_anim, sizeof(empty.bmodel_anim)))
-            write_fields(field->name, bmodel_anim_fields, q_countof(bmodel_anim_fields), p);
+        write_fields(field->name, bmodel_anim_fields, q_countof(bmodel_anim_fields), p);
         break;
 
     case F_PLAYER_FOG:
-        if (memcmp(p, &empty.player_fog, sizeof(empty.player_fog)))
-            write_fields(field->name, player_fog_fields, q_countof(player_fog_fields), p);
+        write_fields(field->name, player_fog_fields, q_countof(player_fog_fields), p);
         break;
 
     case F_PLAYER_HEIGHTFOG:
-        if (memcmp(p, &empty.player_heightfog, sizeof(empty.player_heightfog)))
-            write_fields(field->name, player_heightfog_fields, q_countof(player_heightfog_fields), p);
+        write_fields(field->name, player_heightfog_fields, q_countof(player_heightfog_fields), p);
         break;
 
     case F_LEVEL_ENTRY:
@@ -1087,25 +1466,24 @@ static void write_fields(const char *name, const save_field_t *fields, int count
 // reading
 //
 
+/*
+Whole savegame is decompressed into one buffer and tokenized in place: word
+tokens are terminated by temporarily overwriting the following character,
+quoted strings are unescaped over themselves.
+*/
 static struct {
-    char data[MAX_STRING_CHARS * 4];
-    char token[MAX_STRING_CHARS];
-    const char *ptr;
+    char *data;         // whole file, NUL terminated
+    char *end;
+    char *ptr;          // current position
+    char *token;        // last token, points into data
+    char *term;         // where token terminator was written
+    char saved;         // character overwritten by terminator
     int len;
     int number;
     int version;
     const char *filename;
 } line;
 
-static const char *read_line(void)
-{
-    line.number++;
-    line.ptr = gzgets(fp, line.data, sizeof(line.data));
-    if (!line.ptr)
-        gi.error("%s: error reading input file", line.filename);
-    return line.ptr;
-}
-
 q_noreturn q_cold q_printf(1, 2)
 static void parse_error(const char *fmt, ...)
 {
@@ -1135,14 +1513,16 @@ static int unescape_char(int c)
     return 0;
 }
 
-static void parse_quoted(const char *s)
+static void parse_quoted(char *s)
 {
-    int len = 0;
+    char *d = s;
+
+    line.token = d;
 
     while (1) {
         int c;
 
-        if (!*s)
+        if (!*s || *s == '\n')
             parse_error("unterminated quoted string");
 
         if (*s == '\"') {
@@ -1167,58 +1547,74 @@ static void parse_quoted(const char *s)
             c = *s++;
         }
 
-        if (len == sizeof(line.token) - 1)
-            parse_error("oversize token");
-
-        line.token[len++] = c;
+        *d++ = c;
     }
 
-    line.len = len;
+    // unescaped string is never longer, terminator lands inside consumed
+    // part of the buffer and needs not be restored
+    *d = 0;
+    line.len = d - line.token;
     line.ptr = s;
 }
 
-static void parse_word(const char *s)
+static void parse_word(char *s)
 {
-    int len = 0;
+    line.token = s;
 
     do {
-        if (len == sizeof(line.token) - 1)
-            parse_error("oversize token");
-        line.token[len++] = *s++;
+        s++;
     } while (*s > 32);
 
-    line.len = len;
+    line.len = s - line.token;
+    line.term = s;
+    line.saved = *s;
     line.ptr = s;
+    *s = 0;
+}
+
+static void restore_term(void)
+{
+    if (line.term) {
+        *line.term = line.saved;
+        line.term = NULL;
+    }
+}
+
+static void skip_line(void)
+{
+    char *p = strchr(line.ptr, '\n');
+
+    line.ptr = p ? p : line.end;
 }
 
 static char *parse(void)
 {
-    const char *s = line.ptr;
+    char *s;
 
-    if (!s)
-        s = read_line();
+    restore_term();
+
+    s = line.ptr;
 skip:
     while (*s <= 32) {
-        if (!*s) {
-            s = read_line();
-            continue;
-        }
+        if (*s == '\n')
+            line.number++;
+        else if (!*s && s == line.end)
+            parse_error("unexpected end of file");
         s++;
     }
 
     if (*s == '/' && s[1] == '/') {
-        s = read_line();
+        line.ptr = s;
+        skip_line();
+        s = line.ptr;
         goto skip;
     }
 
-    if (*s == '\"') {
-        s++;
-        parse_quoted(s);
-    } else {
+    if (*s == '\"')
+        parse_quoted(s + 1);
+    else
         parse_word(s);
-    }
 
-    line.token[line.len] = 0;
     return line.token;
 }
 
@@ -1238,14 +1634,104 @@ static void unknown(const char *what)
         parse_error("unknown %s: %s", what, token);
 
     gi.dprintf("WARNING: %s: line %d: unknown %s: %s\n", line.filename, line.number, what, token);
-    line.ptr = NULL;    // skip to next line
+    restore_term();
+    skip_line();
+}
+
+/*
+Numbers are parsed by hand in the forms text_printf() writes them, anything
+else falls back to strtol() and friends.
+*/
+
+// parses decimal or 0x prefixed hexadecimal number without sign, returns
+// false if token is anything else or too long
+static bool parse_digits(const char *s, uint64_t *v)
+{
+    uint64_t n = 0;
+    int i, c;
+
+    if (s[0] == '0' && s[1] == 'x') {
+        for (i = 2; i < 18 && (c = Q_charhex(s[i])) != -1; i++)
+            n = (n << 4) | c;
+        if (i == 2)
+            return false;
+    } else {
+        if (s[0] == '0' && s[1])
+            return false;   // octal
+        for (i = 0; i < 19 && Q_isdigit(s[i]); i++)
+            n = n * 10 + s[i] - '0';
+        if (!i)
+            return false;
+    }
+
+    if (s[i])
+        return false;
+
+    *v = n;
+    return true;
+}
+
+static const double powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10
+};
+
+// parses float with at most 2^24 mantissa and small exponent, which covers
+// %.6g output. Mantissa and power of ten are then exact and rounding single
+// division or multiplication through double gives correctly rounded float,
+// same as strtof(). Returns false for anything else.
+static bool parse_float_digits(const char *s, float *v)
+{
+    bool neg = *s == '-';
+    uint32_t m = 0;
+    int digits = 0, exp = 0;
+    double d;
+
+    s += neg;
+    for (; Q_isdigit(*s) && digits < 10; s++, digits++)
+        m = m * 10 + *s - '0';
+    if (*s == '.')
+        for (s++; Q_isdigit(*s) && digits < 10; s++, digits++, exp--)
+            m = m * 10 + *s - '0';
+    if (!digits)
+        return false;
+
+    if (*s == 'e') {
+        bool exp_neg = *++s == '-';
+        int e = 0, n;
+
+        s += (*s == '-' || *s == '+');
+        for (n = 0; Q_isdigit(*s) && n < 3; s++, n++)
+            e = e * 10 + *s - '0';
+        if (!n)
+            return false;
+        exp += exp_neg ? -e : e;
+    }
+
+    if (*s || m > 1 << 24 || exp < -10 || exp > 10)
+        return false;
+
+    if (exp < 0)
+        d = m / powers_of_ten[-exp];
+    else
+        d = m * powers_of_ten[exp];
+
+    *v = neg ? -d : d;
+    return true;
 }
 
 static int parse_int_tok(const char *tok, int v_min, int v_max)
 {
     char *end;
+    uint64_t u;
     long v;
 
+    if (parse_digits(tok + (*tok == '-'), &u) && u <= INT32_MAX + 1ULL) {
+        int64_t i = *tok == '-' ? -(int64_t)u : (int64_t)u;
+        if (i < v_min || i > v_max)
+            parse_error("value out of range: %"PRId64, i);
+        return i;
+    }
+
     v = strtol(tok, &end, 0);
     if (end == tok || *end)
         parse_error("expected int, got %s", COM_MakePrintable(tok));
@@ -1275,6 +1761,13 @@ static unsigned parse_uint_tok(const char *tok, unsigned v_max)
 {
     char *end;
     unsigned long v;
+    uint64_t u;
+
+    if (parse_digits(tok, &u)) {
+        if (u > v_max)
+            parse_error("value out of range: %"PRIu64, u);
+        return u;
+    }
 
     v = strtoul(tok, &end, 0);
     if (end == tok || *end)
@@ -1305,6 +1798,9 @@ static float parse_float(void)
     float v;
 
     tok = parse();
+    if (parse_float_digits(tok, &v))
+        return v;
+
     v = strtof(tok, &end);
     if (end == tok || *end)
         parse_error("expected float, got %s", COM_MakePrintable(tok));
@@ -1318,6 +1814,9 @@ static uint64_t parse_uint64(void)
     uint64_t v;
 
     tok = parse();
+    if (parse_digits(tok + (*tok == '-'), &v))
+        return *tok == '-' ? -v : v;
+
     v = strtoull(tok, &end, 0);
     if (end == tok || *end)
         parse_error("expected int, got %s", COM_MakePrintable(tok));
@@ -1402,19 +1901,24 @@ static int saveptrcmp(const void *p1, const void *p2)
     return strcmp(((const save_ptr_t *)p1)->name, ((const save_ptr_t *)p2)->name);
 }
 
-static void *read_pointer(ptr_type_t type)
+static const void *find_pointer(const char *name, ptr_type_t type)
 {
     const save_ptr_t *ptr;
 
-    save_ptr_t k = { .name = parse() };
+    save_ptr_t k = { .name = name };
     ptr = bsearch(&k, save_ptrs[type], num_save_ptrs[type], sizeof(save_ptr_t), saveptrcmp);
 
-    if (!ptr) {
+    return ptr ? ptr->ptr : NULL;
+}
+
+static void *read_pointer(ptr_type_t type)
+{
+    const void *ptr = find_pointer(parse(), type);
+
+    if (!ptr)
         unknown("pointer");
-        return NULL;
-    }
 
-    return (void *)ptr->ptr;
+    return (void *)ptr;
 }
 
 static void read_inventory(int *inven)
@@ -1470,7 +1974,7 @@ static void read_stats(int16_t *stats)
     }
 }
 
-static void read_fields(const save_field_t *fields, int count, void *base);
+static void read_fields(save_table_t table, void *base);
 
 static void read_reinforcements(reinforcement_list_t *list)
 {
@@ -1481,7 +1985,7 @@ static void read_reinforcements(reinforcement_list_t *list)
     list->num_reinforcements = count;
     list->reinforcements = gi.TagMalloc(sizeof(list->reinforcements[0]) * count, TAG_LEVEL);
     while ((num = parse_array(count)) != -1)
-        read_fields(reinforcement_fields, q_countof(reinforcement_fields), &list->reinforcements[num]);
+        read_fields(ST_REINFORCEMENT, &list->reinforcements[num]);
 }
 
 static void read_level_entries(level_entry_t *entries)
@@ -1490,7 +1994,7 @@ static void read_level_entries(level_entry_t *entries)
 
     expect("{");
     while ((num = parse_array(MAX_LEVELS_PER_UNIT)) != -1)
-        read_fields(level_entry_fields, q_countof(level_entry_fields), &entries[num]);
+        read_fields(ST_LEVEL_ENTRY, &entries[num]);
 }
 
 static void read_field(const save_field_t *field, void *base)
@@ -1549,10 +2053,6 @@ static void read_field(const save_field_t *field, void *base)
         *(void **)p = read_pointer(field->size);
         break;
 
-    case F_CLIENT_PERSISTENT:
-        read_fields(client_persistent_fields, q_countof(client_persistent_fields), p);
-        break;
-
     case F_INVENTORY:
         read_inventory(p);
         break;
@@ -1563,57 +2063,1252 @@ static void read_field(const save_field_t *field, void *base)
         read_stats(p);
         break;
 
-    case F_MOVEINFO:
-        read_fields(moveinfo_fields, q_countof(moveinfo_fields), p);
-        break;
+    case F_REINFORCEMENTS:
+        read_reinforcements(p);
+        break;
+
+    case F_LEVEL_ENTRY:
+        read_level_entries(p);
+        break;
+
+    default:
+        read_fields(nested_table(field->type), p);
+        break;
+    }
+}
+
+static void read_fields(save_table_t table, void *base)
+{
+    const save_field_t *f;
+    const char *tok;
+    int i;
+
+    expect("{");
+    while (1) {
+        tok = parse();
+        if (!strcmp(tok, "}"))
+            break;
+        i = G_FindName(&save_hashes[table], tok);
+        f = i == -1 ? NULL : &save_tables[table].fields[i];
+        if (!f || strcmp(f->name, tok))
+            unknown("field");
+        else
+            read_field(f, base);
+    }
+}
+
+
+/*
+==============================================================================
+
+BINARY FORMAT
+
+Binary savegames are written when g_binary_saves is set. They are described
+by the same field tables as text savegames, and are loaded transparently
+regardless of g_binary_saves value.
+
+File starts with magic and version, followed by string table holding all
+NUL-terminated strings referenced by the savegame. Then comes schema: for
+each table, number of fields and (name, type, size) of every field. Records
+follow, each record is a sequence of (field id, value) pairs terminated by
+BIN_END_OF_RECORD. Field id is index into schema of the table. Values are
+raw little-endian numbers, strings, items and pointers are string table
+offsets, edicts and clients are indices. Nested structures are nested
+records. Field id with BIN_CLEAR_FIELD bit set has no value and resets the
+field to default, this is only used by delta savegames.
+
+When loading, file schema is matched against field tables by name once, so
+fields can be added, removed or reordered without breaking old savegames.
+Field type codes are stored in file, so fieldtype_t must never be reordered.
+
+==============================================================================
+*/
+
+#define BIN_END_OF_RECORD   0xffff
+#define BIN_CLEAR_FIELD     0x8000
+#define BIN_END_OF_LIST     0xffffffff
+
+//
+// binary writing
+//
+
+static struct {
+    save_buffer_t   data;
+    save_buffer_t   strings;
+    uint32_t        *hash;      // string offsets + 1
+    uint32_t        hash_size;
+    uint32_t        num_strings;
+} bin;
+
+static uint32_t bin_hash_string(const char *s, size_t len)
+{
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < len; i++)
+        hash = (hash ^ (byte)s[i]) * 16777619u;
+
+    return hash;
+}
+
+static void bin_rehash(uint32_t hash_size)
+{
+    uint32_t *hash = gi.TagMalloc(hash_size * sizeof(hash[0]), TAG_SAVE);
+
+    memset(hash, 0, hash_size * sizeof(hash[0]));
+    for (uint32_t i = 0; i < bin.hash_size; i++) {
+        uint32_t ofs = bin.hash[i];
+        if (!ofs)
+            continue;
+        const char *s = (const char *)bin.strings.data + ofs - 1;
+        uint32_t j = bin_hash_string(s, strlen(s));
+        while (hash[j & (hash_size - 1)])
+            j++;
+        hash[j & (hash_size - 1)] = ofs;
+    }
+
+    if (bin.hash)
+        gi.TagFree(bin.hash);
+    bin.hash = hash;
+    bin.hash_size = hash_size;
+}
+
+// returns string table offset of the string, adding it if needed
+static uint32_t bin_intern(const char *s)
+{
+    size_t len = strlen(s);
+    uint32_t i, ofs;
+
+    if (bin.num_strings >= bin.hash_size / 2)
+        bin_rehash(bin.hash_size * 2);
+
+    for (i = bin_hash_string(s, len); (ofs = bin.hash[i & (bin.hash_size - 1)]); i++) {
+        const char *t = (const char *)bin.strings.data + ofs - 1;
+        if (!memcmp(s, t, len + 1))
+            return ofs - 1;
+    }
+
+    ofs = bin.strings.size;
+    memcpy(buf_alloc(&bin.strings, len + 1), s, len + 1);
+    bin.hash[i & (bin.hash_size - 1)] = ofs + 1;
+    bin.num_strings++;
+    return ofs;
+}
+
+static void bin_write_u8(int v)
+{
+    *buf_alloc(&bin.data, 1) = v;
+}
+
+static void bin_write_u16(int v)
+{
+    uint16_t s = LittleShort(v);
+    memcpy(buf_alloc(&bin.data, sizeof(s)), &s, sizeof(s));
+}
+
+static void bin_write_u32(uint32_t v)
+{
+    uint32_t l = LittleLong(v);
+    memcpy(buf_alloc(&bin.data, sizeof(l)), &l, sizeof(l));
+}
+
+static void bin_write_u64(uint64_t v)
+{
+    uint64_t l = LittleLong64(v);
+    memcpy(buf_alloc(&bin.data, sizeof(l)), &l, sizeof(l));
+}
+
+static void bin_write_string(const char *s)
+{
+    bin_write_u32(bin_intern(s));
+}
+
+static void bin_write_short_v(const int16_t *v, int n)
+{
+    byte *p = buf_alloc(&bin.data, n * sizeof(uint16_t));
+
+    for (int i = 0; i < n; i++) {
+        uint16_t s = LittleShort(v[i]);
+        memcpy(p + i * sizeof(s), &s, sizeof(s));
+    }
+}
+
+// also used for floats, which are written as raw bits
+static void bin_write_int_v(const void *v, int n)
+{
+    byte *p = buf_alloc(&bin.data, n * sizeof(uint32_t));
+
+    for (int i = 0; i < n; i++) {
+        uint32_t l;
+        memcpy(&l, (const byte *)v + i * sizeof(l), sizeof(l));
+        l = LittleLong(l);
+        memcpy(p + i * sizeof(l), &l, sizeof(l));
+    }
+}
+
+static void bin_write_fields(save_table_t table, const void *base);
+
+static void bin_write_inventory(const int *inven)
+{
+    int i, count = 0;
+
+    for (i = IT_NULL + 1; i < IT_TOTAL; i++)
+        if (inven[i])
+            count++;
+
+    bin_write_u32(count);
+    for (i = IT_NULL + 1; i < IT_TOTAL; i++) {
+        if (inven[i]) {
+            Q_assert(itemlist[i].classname);
+            bin_write_string(itemlist[i].classname);
+            bin_write_u32(inven[i]);
+        }
+    }
+}
+
+static void bin_write_max_ammo(const int16_t *max_ammo)
+{
+    int i, count = 0;
+
+    for (i = AMMO_BULLETS; i < AMMO_MAX; i++)
+        if (max_ammo[i])
+            count++;
+
+    bin_write_u32(count);
+    for (i = AMMO_BULLETS; i < AMMO_MAX; i++) {
+        if (max_ammo[i]) {
+            bin_write_string(GetItemByAmmo(i)->classname);
+            bin_write_u16(max_ammo[i]);
+        }
+    }
+}
+
+static void bin_write_stats(const int16_t *stats)
+{
+    int i, count = 0;
+
+    for (i = 0; i < q_countof(statdefs); i++)
+        if (stats[statdefs[i].stat])
+            count++;
+
+    bin_write_u32(count);
+    for (i = 0; i < q_countof(statdefs); i++) {
+        if (stats[statdefs[i].stat]) {
+            bin_write_string(statdefs[i].name);
+            bin_write_u16(stats[statdefs[i].stat]);
+        }
+    }
+}
+
+static void bin_write_reinforcements(const reinforcement_list_t *list)
+{
+    bin_write_u32(list->num_reinforcements);
+    for (int i = 0; i < list->num_reinforcements; i++)
+        bin_write_fields(ST_REINFORCEMENT, &list->reinforcements[i]);
+}
+
+static void bin_write_level_entries(const level_entry_t *entries)
+{
+    for (int i = 0; i < MAX_LEVELS_PER_UNIT; i++) {
+        if (memcmp(&entries[i], &empty.level_entries[0], sizeof(empty.level_entries[0]))) {
+            bin_write_u32(i);
+            bin_write_fields(ST_LEVEL_ENTRY, &entries[i]);
+        }
+    }
+    bin_write_u32(BIN_END_OF_LIST);
+}
+
+static void bin_write_field(const save_field_t *field, const void *p)
+{
+    switch (field->type) {
+    case F_BYTE:
+        memcpy(buf_alloc(&bin.data, field->size), p, field->size);
+        break;
+    case F_SHORT:
+        bin_write_short_v(p, field->size);
+        break;
+    case F_INT:
+    case F_FLOAT:
+    case F_GRAVITY:
+        bin_write_int_v(p, field->size);
+        break;
+    case F_UINT:
+        bin_write_u32(*(unsigned *)p);
+        break;
+    case F_INT64:
+    case F_UINT64:
+        bin_write_u64(*(uint64_t *)p);
+        break;
+    case F_BOOL:
+        break;
+    case F_VECTOR:
+        bin_write_int_v(p, 3);
+        break;
+
+    case F_ZSTRING:
+        bin_write_string(p);
+        break;
+    case F_LSTRING:
+    case F_GSTRING:
+        bin_write_string(*(char **)p);
+        break;
+
+    case F_EDICT:
+        bin_write_u32(*(edict_t **)p - g_edicts);
+        break;
+    case F_CLIENT:
+        bin_write_u32(*(gclient_t **)p - game.clients);
+        break;
+
+    case F_ITEM:
+        bin_write_string((*(gitem_t **)p)->classname);
+        break;
+    case F_POINTER:
+        bin_write_string(pointer_name(*(void **)p, field->size));
+        break;
+
+    case F_INVENTORY:
+        bin_write_inventory(p);
+        break;
+    case F_MAX_AMMO:
+        bin_write_max_ammo(p);
+        break;
+    case F_STATS:
+        bin_write_stats(p);
+        break;
+
+    case F_REINFORCEMENTS:
+        bin_write_reinforcements(p);
+        break;
+    case F_LEVEL_ENTRY:
+        bin_write_level_entries(p);
+        break;
+
+    default:
+        bin_write_fields(nested_table(field->type), p);
+        break;
+    }
+}
+
+static void bin_write_fields(save_table_t table, const void *base)
+{
+    const save_field_t *fields = save_tables[table].fields;
+    int count = save_tables[table].count;
+
+    for (int i = 0; i < count; i++) {
+        const save_field_t *field = &fields[i];
+        const void *p = (const byte *)base + field->ofs;
+
+        if (!field_empty(field, p)) {
+            bin_write_u16(i);
+            bin_write_field(field, p);
+        }
+    }
+    bin_write_u16(BIN_END_OF_RECORD);
+}
+
+static void bin_begin_write(void)
+{
+    memset(&bin, 0, sizeof(bin));
+    bin_rehash(1024);
+
+    // schema goes first, records follow
+    bin_write_u32(ST_TOTAL);
+    for (int i = 0; i < ST_TOTAL; i++) {
+        bin_write_u32(save_tables[i].count);
+        for (int j = 0; j < save_tables[i].count; j++) {
+            const save_field_t *field = &save_tables[i].fields[j];
+            bin_write_string(field->name);
+            bin_write_u16(field->type);
+            bin_write_u16(field->size);
+        }
+    }
+}
+
+static void bin_finish_write(const char *filename, const char *magic)
+{
+    save_buffer_t chunks[3] = { 0 };
+    uint32_t header[2];
+
+    header[0] = LittleLong(SAVE_VERSION_CURRENT);
+    header[1] = LittleLong(bin.strings.size);
+    memcpy(buf_alloc(&chunks[0], 4), magic, 4);
+    memcpy(buf_alloc(&chunks[0], sizeof(header)), header, sizeof(header));
+
+    chunks[1] = bin.strings;
+    chunks[2] = bin.data;
+    gi.TagFree(bin.hash);
+    memset(&bin, 0, sizeof(bin));
+
+    // binary savegames are compact already, favor speed over ratio
+#if USE_ZLIB
+    queue_save(filename, "wb1", chunks, 3);
+#else
+    queue_save(filename, "wb", chunks, 3);
+#endif
+}
+
+//
+// binary reading
+//
+
+typedef struct {
+    const char          *name;
+    const save_field_t  *local;     // NULL if field is unknown
+    uint16_t            type;
+    uint16_t            size;
+} bin_field_t;
+
+static struct {
+    save_buffer_t   file;
+    const byte      *ptr, *end;
+    const char      *strings;
+    uint32_t        strings_size;
+    bin_field_t     *schema[ST_TOTAL];
+    uint32_t        num_fields[ST_TOTAL];
+} bin_in;
+
+q_noreturn q_cold q_printf(1, 2)
+static void bin_error(const char *fmt, ...)
+{
+    va_list     argptr;
+    char        text[MAX_STRING_CHARS];
+
+    va_start(argptr, fmt);
+    Q_vsnprintf(text, sizeof(text), fmt, argptr);
+    va_end(argptr);
+
+    gi.error("%s: offset %td: %s", line.filename, bin_in.ptr - bin_in.file.data, text);
+}
+
+static void bin_unknown(const char *what, const char *name)
+{
+    name = COM_MakePrintable(name);
+
+    if (g_strict_saves->integer)
+        bin_error("unknown %s: %s", what, name);
+
+    gi.dprintf("WARNING: %s: unknown %s: %s\n", line.filename, what, name);
+}
+
+static const byte *bin_read_data(size_t len)
+{
+    const byte *p = bin_in.ptr;
+
+    if (len > bin_in.end - p)
+        bin_error("unexpected end of file");
+
+    bin_in.ptr += len;
+    return p;
+}
+
+static int bin_read_u16(void)
+{
+    uint16_t s;
+    memcpy(&s, bin_read_data(sizeof(s)), sizeof(s));
+    return LittleShort(s);
+}
+
+static uint32_t bin_read_u32(void)
+{
+    uint32_t l;
+    memcpy(&l, bin_read_data(sizeof(l)), sizeof(l));
+    return LittleLong(l);
+}
+
+static uint64_t bin_read_u64(void)
+{
+    uint64_t l;
+    memcpy(&l, bin_read_data(sizeof(l)), sizeof(l));
+    return LittleLong64(l);
+}
+
+static uint32_t bin_read_uint(uint32_t v_max)
+{
+    uint32_t v = bin_read_u32();
+
+    if (v > v_max)
+        bin_error("value out of range: %u", v);
+
+    return v;
+}
+
+static int bin_read_array(uint32_t count)
+{
+    uint32_t v = bin_read_u32();
+
+    if (v == BIN_END_OF_LIST)
+        return -1;
+
+    if (v >= count)
+        bin_error("index out of range: %u", v);
+
+    return v;
+}
+
+static const char *bin_read_string(void)
+{
+    uint32_t ofs = bin_read_u32();
+
+    if (ofs >= bin_in.strings_size)
+        bin_error("bad string offset: %u", ofs);
+
+    return bin_in.strings + ofs;
+}
+
+static void bin_read_short_v(int16_t *v, int n)
+{
+    const byte *p = bin_read_data(n * sizeof(uint16_t));
+
+    for (int i = 0; i < n; i++) {
+        uint16_t s;
+        memcpy(&s, p + i * sizeof(s), sizeof(s));
+        v[i] = LittleShort(s);
+    }
+}
+
+static void bin_read_int_v(void *v, int n)
+{
+    const byte *p = bin_read_data(n * sizeof(uint32_t));
+
+    for (int i = 0; i < n; i++) {
+        uint32_t l;
+        memcpy(&l, p + i * sizeof(l), sizeof(l));
+        l = LittleLong(l);
+        memcpy((byte *)v + i * sizeof(l), &l, sizeof(l));
+    }
+}
+
+static char *bin_read_tag_string(int tag)
+{
+    const char *s = bin_read_string();
+    size_t len = strlen(s);
+    char *d = gi.TagMalloc(len + 1, tag);
+
+    memcpy(d, s, len + 1);
+    return d;
+}
+
+static void bin_skip_fields(save_table_t table);
+
+// skips field in file that has no local counterpart
+static void bin_skip_field(int type, int size)
+{
+    uint32_t i, count;
+
+    switch (type) {
+    case F_BYTE:
+        bin_read_data(size);
+        break;
+    case F_SHORT:
+        bin_read_data(size * sizeof(uint16_t));
+        break;
+    case F_INT:
+    case F_FLOAT:
+    case F_GRAVITY:
+        bin_read_data(size * sizeof(uint32_t));
+        break;
+    case F_UINT:
+    case F_LSTRING:
+    case F_GSTRING:
+    case F_ZSTRING:
+    case F_EDICT:
+    case F_CLIENT:
+    case F_ITEM:
+    case F_POINTER:
+        bin_read_data(sizeof(uint32_t));
+        break;
+    case F_INT64:
+    case F_UINT64:
+        bin_read_data(sizeof(uint64_t));
+        break;
+    case F_BOOL:
+        break;
+    case F_VECTOR:
+        bin_read_data(sizeof(uint32_t) * 3);
+        break;
+
+    case F_INVENTORY:
+        count = bin_read_u32();
+        for (i = 0; i < count; i++)
+            bin_read_data(sizeof(uint32_t) * 2);
+        break;
+    case F_MAX_AMMO:
+    case F_STATS:
+        count = bin_read_u32();
+        for (i = 0; i < count; i++)
+            bin_read_data(sizeof(uint32_t) + sizeof(uint16_t));
+        break;
+
+    case F_REINFORCEMENTS:
+        count = bin_read_uint(MAX_REINFORCEMENTS_TOTAL);
+        for (i = 0; i < count; i++)
+            bin_skip_fields(ST_REINFORCEMENT);
+        break;
+    case F_LEVEL_ENTRY:
+        while (bin_read_array(MAX_LEVELS_PER_UNIT) != -1)
+            bin_skip_fields(ST_LEVEL_ENTRY);
+        break;
+
+    default:
+        if (nested_table(type) == -1)
+            bin_error("bad field type: %d", type);
+        bin_skip_fields(nested_table(type));
+        break;
+    }
+}
+
+static void bin_skip_fields(save_table_t table)
+{
+    int id;
+
+    while ((id = bin_read_u16()) != BIN_END_OF_RECORD) {
+        if ((id & ~BIN_CLEAR_FIELD) >= bin_in.num_fields[table])
+            bin_error("bad field id: %d", id);
+        if (!(id & BIN_CLEAR_FIELD))
+            bin_skip_field(bin_in.schema[table][id].type, bin_in.schema[table][id].size);
+    }
+}
+
+static void bin_read_fields(save_table_t table, void *base);
+
+static void bin_read_inventory(int *inven)
+{
+    uint32_t count = bin_read_uint(IT_TOTAL);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const char *name = bin_read_string();
+        int v = bin_read_u32();
+        const gitem_t *item = FindItemByClassname(name);
+        if (item)
+            inven[item->id] = v;
+        else
+            bin_unknown("item", name);
+    }
+}
+
+static void bin_read_max_ammo(int16_t *max_ammo)
+{
+    uint32_t count = bin_read_uint(IT_TOTAL);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const char *name = bin_read_string();
+        int v = (int16_t)bin_read_u16();
+        const gitem_t *item = FindItemByClassname(name);
+        if (item && (item->flags & IF_AMMO))
+            max_ammo[item->tag] = v;
+        else
+            bin_unknown("ammo", name);
+    }
+}
+
+static void bin_read_stats(int16_t *stats)
+{
+    uint32_t count = bin_read_uint(MAX_STATS);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const char *name = bin_read_string();
+        int v = (int16_t)bin_read_u16();
+        int j;
+        for (j = 0; j < q_countof(statdefs); j++)
+            if (!strcmp(name, statdefs[j].name))
+                break;
+        if (j < q_countof(statdefs))
+            stats[statdefs[j].stat] = v;
+        else
+            bin_unknown("stat", name);
+    }
+}
+
+static void bin_read_reinforcements(reinforcement_list_t *list)
+{
+    uint32_t count = bin_read_uint(MAX_REINFORCEMENTS_TOTAL);
+
+    if (!count)
+        bin_error("no reinforcements");
+
+    list->num_reinforcements = count;
+    list->reinforcements = gi.TagMalloc(sizeof(list->reinforcements[0]) * count, TAG_LEVEL);
+    for (uint32_t i = 0; i < count; i++)
+        bin_read_fields(ST_REINFORCEMENT, &list->reinforcements[i]);
+}
+
+static void bin_read_level_entries(level_entry_t *entries)
+{
+    int num;
+
+    while ((num = bin_read_array(MAX_LEVELS_PER_UNIT)) != -1)
+        bin_read_fields(ST_LEVEL_ENTRY, &entries[num]);
+}
+
+static void bin_read_field(const save_field_t *field, void *base)
+{
+    void *p = (byte *)base + field->ofs;
+    const char *s;
+
+    switch (field->type) {
+    case F_BYTE:
+        memcpy(p, bin_read_data(field->size), field->size);
+        break;
+    case F_SHORT:
+        bin_read_short_v(p, field->size);
+        break;
+    case F_INT:
+    case F_FLOAT:
+    case F_GRAVITY:
+        bin_read_int_v(p, field->size);
+        break;
+    case F_UINT:
+        *(unsigned *)p = bin_read_u32();
+        break;
+    case F_INT64:
+    case F_UINT64:
+        *(uint64_t *)p = bin_read_u64();
+        break;
+    case F_BOOL:
+        *(bool *)p = true;
+        break;
+    case F_VECTOR:
+        bin_read_int_v(p, 3);
+        break;
+
+    case F_LSTRING:
+        *(char **)p = bin_read_tag_string(TAG_LEVEL);
+        break;
+    case F_GSTRING:
+        *(char **)p = bin_read_tag_string(TAG_GAME);
+        break;
+    case F_ZSTRING:
+        if (Q_strlcpy(p, bin_read_string(), field->size) >= field->size)
+            bin_error("oversize string");
+        break;
+
+    case F_EDICT:
+        *(edict_t **)p = &g_edicts[bin_read_uint(game.maxentities - 1)];
+        break;
+    case F_CLIENT:
+        *(gclient_t **)p = &game.clients[bin_read_uint(game.maxclients - 1)];
+        break;
+
+    case F_ITEM:
+        s = bin_read_string();
+        if (!(*(const gitem_t **)p = FindItemByClassname(s)))
+            bin_unknown("item", s);
+        break;
+    case F_POINTER:
+        s = bin_read_string();
+        if (!(*(const void **)p = find_pointer(s, field->size)))
+            bin_unknown("pointer", s);
+        break;
+
+    case F_INVENTORY:
+        bin_read_inventory(p);
+        break;
+    case F_MAX_AMMO:
+        bin_read_max_ammo(p);
+        break;
+    case F_STATS:
+        bin_read_stats(p);
+        break;
+
+    case F_REINFORCEMENTS:
+        bin_read_reinforcements(p);
+        break;
+    case F_LEVEL_ENTRY:
+        bin_read_level_entries(p);
+        break;
+
+    default:
+        bin_read_fields(nested_table(field->type), p);
+        break;
+    }
+}
+
+// resets field to the value it has in freshly initialized structure
+static void clear_field(const save_field_t *field, void *base)
+{
+    void *p = (byte *)base + field->ofs;
+
+    if (field->type == F_GRAVITY && field->size == 1)
+        *(float *)p = 1.0f;
+    else if (field->type == F_GRAVITY)
+        VectorCopy(default_gravity, (float *)p);
+    else
+        memset(p, 0, field_size(field));
+}
+
+static void bin_read_fields(save_table_t table, void *base)
+{
+    int id;
+
+    while ((id = bin_read_u16()) != BIN_END_OF_RECORD) {
+        bool clear = id & BIN_CLEAR_FIELD;
+
+        id &= ~BIN_CLEAR_FIELD;
+        if (id >= bin_in.num_fields[table])
+            bin_error("bad field id: %d", id);
+
+        const bin_field_t *f = &bin_in.schema[table][id];
+        if (!f->local) {
+            bin_unknown("field", f->name);
+            if (!clear)
+                bin_skip_field(f->type, f->size);
+        } else if (clear) {
+            clear_field(f->local, base);
+        } else {
+            bin_read_field(f->local, base);
+        }
+    }
+}
 
-    case F_MONSTERINFO:
-        read_fields(monsterinfo_fields, q_countof(monsterinfo_fields), p);
-        break;
+// finds local field matching file field, types must agree
+static const save_field_t *bin_match_field(save_table_t table, const bin_field_t *f)
+{
+    int i = G_FindName(&save_hashes[table], f->name);
+    const save_field_t *field;
 
-    case F_REINFORCEMENTS:
-        read_reinforcements(p);
-        break;
+    if (i == -1)
+        return NULL;
+    field = &save_tables[table].fields[i];
+    if (strcmp(field->name, f->name))
+        return NULL;
+    if (field->type != f->type)
+        return NULL;
+    if (field->size != f->size && f->type != F_ZSTRING)
+        return NULL;
 
-    case F_BMODEL_ANIM:
-        read_fields(bmodel_anim_fields, q_countof(bmodel_anim_fields), p);
-        break;
+    return field;
+}
 
-    case F_PLAYER_FOG:
-        read_fields(player_fog_fields, q_countof(player_fog_fields), p);
-        break;
+static void bin_read_schema(void)
+{
+    uint32_t num_tables = bin_read_u32();
 
-    case F_PLAYER_HEIGHTFOG:
-        read_fields(player_heightfog_fields, q_countof(player_heightfog_fields), p);
-        break;
+    if (num_tables > ST_TOTAL)
+        bin_error("too many tables: %u", num_tables);
 
-    case F_LEVEL_ENTRY:
-        read_level_entries(p);
-        break;
+    for (uint32_t i = 0; i < num_tables; i++) {
+        uint32_t count = bin_read_uint(BIN_CLEAR_FIELD - 1);
+        bin_field_t *fields = gi.TagMalloc(count * sizeof(fields[0]) + 1, TAG_SAVE);
+
+        for (uint32_t j = 0; j < count; j++) {
+            bin_field_t *f = &fields[j];
+            f->name = bin_read_string();
+            f->type = bin_read_u16();
+            f->size = bin_read_u16();
+            f->local = bin_match_field(i, f);
+        }
+
+        bin_in.schema[i] = fields;
+        bin_in.num_fields[i] = count;
     }
 }
 
-static void read_fields(const save_field_t *fields, int count, void *base)
+// takes ownership of the file loaded into memory and parses header
+static void bin_begin_read(const save_buffer_t *file)
 {
-    const save_field_t *f;
-    const char *tok;
+    memset(&bin_in, 0, sizeof(bin_in));
+
+    bin_in.file = *file;
+    bin_in.ptr = bin_in.file.data + 4;  // skip magic
+    bin_in.end = bin_in.file.data + bin_in.file.size;
+
+    line.version = bin_read_u32();
+    if (line.version < SAVE_VERSION_MINIMUM || line.version > SAVE_VERSION_CURRENT)
+        gi.error("Savegame has bad version");
+
+    bin_in.strings_size = bin_read_u32();
+    bin_in.strings = (const char *)bin_read_data(bin_in.strings_size);
+    if (bin_in.strings_size && bin_in.strings[bin_in.strings_size - 1])
+        bin_error("unterminated string table");
+
+    bin_read_schema();
+}
+
+static void text_finish_read(void)
+{
+    gi.FreeTags(TAG_SAVE);
+    memset(&line, 0, sizeof(line));
+}
+
+static void bin_finish_read(void)
+{
+    if (bin_in.ptr != bin_in.end)
+        bin_error("trailing data");
+
+    gi.FreeTags(TAG_SAVE);
+    memset(&bin_in, 0, sizeof(bin_in));
+}
+
+/*
+==============================================================================
+
+DELTA SAVEGAMES
+
+Level savegames are written as delta against spawn baseline when
+g_delta_saves is set. Baseline is a copy of entities taken right after
+SpawnEntities, which is called the same way before ReadLevel. Entities that
+were present in baseline are written as delta records holding only fields
+that differ, other entities are written in full. Entities removed since
+spawn are simply not written, as with normal savegames.
+
+Loading delta record is equivalent to loading full record: non-default
+baseline fields are copied the same way they would be read from file, then
+delta is applied. Spawning is seeded from map name and starts from empty
+edict list to make it repeatable. Savegame stores baseline checksum along
+with skill, coop and deathmatch baseline was spawned with, and ReadLevel
+errors out unless level just spawned matches. Level is written in full if
+these settings are about to change, so that it can be loaded again.
+
+==============================================================================
+*/
+
+// settings level spawning depends on
+typedef struct {
+    int         skill;
+    int         coop;
+    int         deathmatch;
+} spawn_settings_t;
+
+static struct {
+    edict_t             *edicts;
+    int                 num_edicts;
+    spawn_settings_t    settings;
+    uint64_t            checksum;
+} baseline;
+
+static bool fields_equal(save_table_t table, const void *a, const void *b);
+
+// returns true if field has identical value in both structures
+static bool field_equal(const save_field_t *field, const void *a, const void *b)
+{
+    const reinforcement_list_t *la = a, *lb = b;
+    const char *sa, *sb;
     int i;
 
-    expect("{");
-    while (1) {
-        tok = parse();
-        if (!strcmp(tok, "}"))
+    switch (field->type) {
+    case F_BOOL:
+        return *(const bool *)a == *(const bool *)b;
+    case F_ZSTRING:
+        return !strcmp(a, b);
+    case F_LSTRING:
+    case F_GSTRING:
+        sa = *(char *const *)a;
+        sb = *(char *const *)b;
+        if (!sa || !sb)
+            return sa == sb;
+        return !strcmp(sa, sb);
+    case F_STATS:
+        for (i = 0; i < q_countof(statdefs); i++)
+            if (((const int16_t *)a)[statdefs[i].stat] != ((const int16_t *)b)[statdefs[i].stat])
+                return false;
+        return true;
+    case F_REINFORCEMENTS:
+        if (la->num_reinforcements != lb->num_reinforcements)
+            return false;
+        for (i = 0; i < la->num_reinforcements; i++)
+            if (!fields_equal(ST_REINFORCEMENT, &la->reinforcements[i], &lb->reinforcements[i]))
+                return false;
+        return true;
+    default:
+        if (nested_table(field->type) != -1)
+            return fields_equal(nested_table(field->type), a, b);
+        return !memcmp(a, b, field_size(field));
+    }
+}
+
+static bool fields_equal(save_table_t table, const void *a, const void *b)
+{
+    const save_field_t *fields = save_tables[table].fields;
+    int count = save_tables[table].count;
+
+    for (int i = 0; i < count; i++)
+        if (!field_equal(&fields[i], (const byte *)a + fields[i].ofs, (const byte *)b + fields[i].ofs))
+            return false;
+
+    return true;
+}
+
+static void dup_fields(save_table_t table, void *base, bool to_baseline);
+
+// replaces strings and lists referenced by field with private copies
+static void dup_field(const save_field_t *field, void *p, bool to_baseline)
+{
+    reinforcement_list_t *list = p;
+    reinforcement_t *r;
+    char **s = p;
+
+    switch (field->type) {
+    case F_LSTRING:
+    case F_GSTRING:
+        if (*s)
+            *s = G_CopyString(*s, to_baseline ? TAG_BASELINE : field->type == F_LSTRING ? TAG_LEVEL : TAG_GAME);
+        break;
+    case F_REINFORCEMENTS:
+        if (!list->num_reinforcements)
             break;
-        for (i = 0, f = fields; i < count; i++, f++)
-            if (!strcmp(f->name, tok))
-                break;
-        if (i == count)
-            unknown("field");
+        r = gi.TagMalloc(sizeof(r[0]) * list->num_reinforcements, to_baseline ? TAG_BASELINE : TAG_LEVEL);
+        memcpy(r, list->reinforcements, sizeof(r[0]) * list->num_reinforcements);
+        list->reinforcements = r;
+        for (int i = 0; i < list->num_reinforcements; i++)
+            dup_fields(ST_REINFORCEMENT, &r[i], to_baseline);
+        break;
+    default:
+        if (nested_table(field->type) != -1)
+            dup_fields(nested_table(field->type), p, to_baseline);
+        break;
+    }
+}
+
+static void dup_fields(save_table_t table, void *base, bool to_baseline)
+{
+    const save_field_t *fields = save_tables[table].fields;
+    int count = save_tables[table].count;
+
+    for (int i = 0; i < count; i++)
+        dup_field(&fields[i], (byte *)base + fields[i].ofs, to_baseline);
+}
+
+// copies non-default baseline fields, as if they were read from file
+static void copy_fields(save_table_t table, void *base, const void *from)
+{
+    const save_field_t *fields = save_tables[table].fields;
+    int count = save_tables[table].count;
+
+    for (int i = 0; i < count; i++) {
+        const save_field_t *field = &fields[i];
+        void *p = (byte *)base + field->ofs;
+        const void *b = (const byte *)from + field->ofs;
+
+        if (field_empty(field, b))
+            continue;
+
+        if (nested_table(field->type) != -1) {
+            copy_fields(nested_table(field->type), p, b);
+        } else {
+            memcpy(p, b, field_size(field));
+            dup_field(field, p, false);
+        }
+    }
+}
+
+// writes fields that differ from baseline
+static void bin_write_delta(save_table_t table, const void *base, const void *from)
+{
+    const save_field_t *fields = save_tables[table].fields;
+    int count = save_tables[table].count;
+
+    for (int i = 0; i < count; i++) {
+        const save_field_t *field = &fields[i];
+        const void *p = (const byte *)base + field->ofs;
+        const void *b = (const byte *)from + field->ofs;
+
+        if (field_equal(field, p, b))
+            continue;
+
+        if (field_empty(field, p)) {
+            bin_write_u16(i | BIN_CLEAR_FIELD);
+            continue;
+        }
+
+        bin_write_u16(i);
+        if (nested_table(field->type) != -1)
+            bin_write_delta(nested_table(field->type), p, b);
         else
-            read_field(f, base);
+            bin_write_field(field, p);
+    }
+    bin_write_u16(BIN_END_OF_RECORD);
+}
+
+// hashes baseline entities encoded the way they would be saved
+static uint64_t baseline_checksum(void)
+{
+    uint64_t checksum;
+
+    memset(&bin, 0, sizeof(bin));
+    bin_rehash(1024);
+
+    for (int i = 0; i < baseline.num_edicts; i++) {
+        if (!baseline.edicts[i].inuse)
+            continue;
+        bin_write_u32(i);
+        bin_write_fields(ST_ENTITY, &baseline.edicts[i]);
+    }
+
+    checksum = (uint64_t)bin_hash_string((const char *)bin.strings.data, bin.strings.size) << 32;
+    checksum |= bin_hash_string((const char *)bin.data.data, bin.data.size);
+
+    buf_free(&bin.strings);
+    buf_free(&bin.data);
+    gi.TagFree(bin.hash);
+    memset(&bin, 0, sizeof(bin));
+
+    return checksum;
+}
+
+static void free_baseline(void)
+{
+    gi.FreeTags(TAG_BASELINE);
+    memset(&baseline, 0, sizeof(baseline));
+}
+
+static void get_spawn_settings(spawn_settings_t *settings)
+{
+    settings->skill = skill->integer;
+    settings->coop = coop->integer;
+    settings->deathmatch = deathmatch->integer;
+}
+
+// g_edicts must hold freshly spawned level
+static void capture_baseline(void)
+{
+    get_spawn_settings(&baseline.settings);
+
+    baseline.num_edicts = globals.num_edicts;
+    baseline.edicts = gi.TagMalloc(baseline.num_edicts * sizeof(baseline.edicts[0]), TAG_BASELINE);
+    memcpy(baseline.edicts, g_edicts, baseline.num_edicts * sizeof(baseline.edicts[0]));
+
+    for (int i = 0; i < baseline.num_edicts; i++)
+        if (baseline.edicts[i].inuse)
+            dup_fields(ST_ENTITY, &baseline.edicts[i], true);
+
+    baseline.checksum = baseline_checksum();
+}
+
+// returns true if level can be spawned again exactly as baseline
+static bool baseline_valid(void)
+{
+    spawn_settings_t settings;
+
+    if (!baseline.edicts)
+        return false;
+
+    // latched values take effect on next spawn
+    if (skill->latched_string || coop->latched_string || deathmatch->latched_string)
+        return false;
+
+    get_spawn_settings(&settings);
+    return !memcmp(&settings, &baseline.settings, sizeof(settings));
+}
+
+// makes sure level just spawned matches the one savegame was written against
+static void load_baseline(const char *filename)
+{
+    spawn_settings_t settings;
+    uint64_t checksum;
+
+    checksum = bin_read_u64();
+    settings.skill = bin_read_u32();
+    settings.coop = bin_read_u32();
+    settings.deathmatch = bin_read_u32();
+
+    if (!baseline.edicts)
+        gi.error("%s: delta savegame requires g_delta_saves 1", filename);
+
+    if (memcmp(&settings, &baseline.settings, sizeof(settings)))
+        gi.error("%s: saved with skill %d, coop %d, deathmatch %d, but level spawned with skill %d, coop %d, deathmatch %d",
+                 filename, settings.skill, settings.coop, settings.deathmatch,
+                 baseline.settings.skill, baseline.settings.coop, baseline.settings.deathmatch);
+
+    if (checksum != baseline.checksum)
+        gi.error("%s: level spawned differently than when saved", filename);
+}
+
+/*
+============
+G_BeginBaseline
+
+Called by SpawnEntities before spawning. Discards baseline of the previous
+level. If delta savegames are enabled, seeds random number generator from
+map name and returns true, caller must then spawn from empty edict list.
+============
+*/
+bool G_BeginBaseline(const char *mapname)
+{
+    free_baseline();
+
+    if (!g_delta_saves->integer)
+        return false;
+
+    Q_srand(bin_hash_string(mapname, strlen(mapname)));
+    return true;
+}
+
+/*
+============
+G_EndBaseline
+
+Called by SpawnEntities after spawning. Takes baseline if delta savegames
+are enabled and reseeds random number generator.
+============
+*/
+void G_EndBaseline(void)
+{
+    if (g_delta_saves->integer) {
+        capture_baseline();
+        Q_srand(time(NULL));
     }
 }
 
+//=========================================================
+
+typedef enum {
+    SAVE_TEXT,
+    SAVE_BINARY,
+    SAVE_DELTA,
+} save_format_t;
+
+// opens savegame for reading and returns its format, delta_magic may be NULL
+static save_format_t open_save(const char *filename, const char *text_magic,
+                               const char *bin_magic, const char *delta_magic)
+{
+    save_buffer_t file = { 0 };
+    int ret;
+
+    wait_saves(true);
+
+    fp = gzopen(filename, "rb");
+    if (!fp)
+        gi.error("Couldn't open %s", filename);
+
+    memset(&line, 0, sizeof(line));
+    line.filename = COM_SkipPath(filename);
+
+    // decompress the whole file at once
+    do {
+        byte *p = buf_alloc(&file, 0x40000);
+        ret = gzread(fp, p, 0x40000);
+        if (ret < 0)
+            gi.error("%s: error reading input file", line.filename);
+        file.size -= 0x40000 - ret;
+    } while (ret);
+
+    gzclose(fp);
+    fp = NULL;
+
+    if (file.size >= 4 && !memcmp(file.data, bin_magic, 4)) {
+        bin_begin_read(&file);
+        return SAVE_BINARY;
+    }
+    if (file.size >= 4 && delta_magic && !memcmp(file.data, delta_magic, 4)) {
+        bin_begin_read(&file);
+        return SAVE_DELTA;
+    }
+
+    // text is tokenized in place and needs terminating NUL
+    *buf_alloc(&file, 1) = 0;
+    line.data = (char *)file.data;
+    line.end = line.data + file.size - 1;
+    line.ptr = line.data;
+    line.number = 1;
+
+    expect(text_magic);
+    expect("version");
+    line.version = parse_int32();
+    if (line.version < SAVE_VERSION_MINIMUM || line.version > SAVE_VERSION_CURRENT)
+        gi.error("Savegame has bad version");
+
+    return SAVE_TEXT;
+}
 
 //=========================================================
 
@@ -1638,12 +3333,26 @@ void WriteGame(const char *filename, qboolean autosave)
     if (!autosave)
         SaveClientData();
 
-    fp = gzopen(filename, "wb");
-    if (!fp)
-        gi.error("Couldn't open %s", filename);
+    if (g_binary_saves->integer) {
+        bin_begin_write();
+
+        game.autosaved = autosave;
+        bin_write_fields(ST_GAME, &game);
+        game.autosaved = false;
+
+        for (i = 0; i < game.maxclients; i++) {
+            bin_write_u32(i);
+            bin_write_fields(ST_CLIENT, &game.clients[i]);
+        }
+        bin_write_u32(BIN_END_OF_LIST);
+
+        bin_finish_write(filename, SAVE_MAGIC1_BIN);
+        wait_saves(true);
+        return;
+    }
 
     memset(&block, 0, sizeof(block));
-    gzprintf(fp, SAVE_MAGIC1 " version %d\n", SAVE_VERSION_CURRENT);
+    text_printf(SAVE_MAGIC1 " version %d\n", SAVE_VERSION_CURRENT);
 
     game.autosaved = autosave;
     write_fields("game", gamefields, q_countof(gamefields), &game);
@@ -1654,10 +3363,10 @@ void WriteGame(const char *filename, qboolean autosave)
         write_fields(va("%d", i), clientfields, q_countof(clientfields), &game.clients[i]);
     end_block();
 
-    i = gzclose(fp);
-    fp = NULL;
-    if (i)
-        gi.error("Couldn't write %s", filename);
+    queue_save(filename, "wb", &text, 1);
+
+    // server copies savegame directory after this returns
+    wait_saves(true);
 }
 
 void ReadGame(const char *filename)
@@ -1666,25 +3375,20 @@ void ReadGame(const char *filename)
 
     gi.FreeTags(TAG_GAME);
 
-    fp = gzopen(filename, "rb");
-    if (!fp)
-        gi.error("Couldn't open %s", filename);
-
-    gzbuffer(fp, 65536);
+    // baseline points into edicts being reallocated
+    free_baseline();
 
-    memset(&line, 0, sizeof(line));
-    line.filename = COM_SkipPath(filename);
-    expect(SAVE_MAGIC1);
-    expect("version");
-    line.version = parse_int32();
-    if (line.version < SAVE_VERSION_MINIMUM || line.version > SAVE_VERSION_CURRENT)
-        gi.error("Savegame has bad version");
+    bool binary = open_save(filename, SAVE_MAGIC1, SAVE_MAGIC1_BIN, NULL) != SAVE_TEXT;
 
     int maxclients = game.maxclients;
     int maxentities = game.maxentities;
 
-    expect("game");
-    read_fields(gamefields, q_countof(gamefields), &game);
+    if (binary) {
+        bin_read_fields(ST_GAME, &game);
+    } else {
+        expect("game");
+        read_fields(ST_GAME, &game);
+    }
 
     // should agree with server's version
     if (game.maxclients != maxclients)
@@ -1699,13 +3403,19 @@ void ReadGame(const char *filename)
 
     game.clients = gi.TagMalloc(game.maxclients * sizeof(game.clients[0]), TAG_GAME);
 
+    if (binary) {
+        while ((num = bin_read_array(game.maxclients)) != -1)
+            bin_read_fields(ST_CLIENT, &game.clients[num]);
+        bin_finish_read();
+        return;
+    }
+
     expect("clients");
     expect("{");
     while ((num = parse_array(game.maxclients)) != -1)
-        read_fields(clientfields, q_countof(clientfields), &game.clients[num]);
+        read_fields(ST_CLIENT, &game.clients[num]);
 
-    gzclose(fp);
-    fp = NULL;
+    text_finish_read();
 }
 
 //==========================================================
@@ -1721,12 +3431,44 @@ void WriteLevel(const char *filename)
     int     i;
     edict_t *ent;
 
-    fp = gzopen(filename, "wb");
-    if (!fp)
-        gi.error("Couldn't open %s", filename);
+    // delta savegames are binary, baseline may be missing if
+    // g_delta_saves was set after level was spawned, or not match
+    // the level spawned next time if settings have changed
+    bool delta = g_delta_saves->integer && baseline_valid();
+
+    if (g_binary_saves->integer || delta) {
+        bin_begin_write();
+        if (delta) {
+            bin_write_u64(baseline.checksum);
+            bin_write_u32(baseline.settings.skill);
+            bin_write_u32(baseline.settings.coop);
+            bin_write_u32(baseline.settings.deathmatch);
+        }
+        bin_write_fields(ST_LEVEL, &level);
+
+        for (i = 0; i < globals.num_edicts; i++) {
+            ent = &g_edicts[i];
+            if (!ent->inuse)
+                continue;
+            bin_write_u32(i);
+            if (delta) {
+                if (i < baseline.num_edicts && baseline.edicts[i].inuse) {
+                    bin_write_u8(1);
+                    bin_write_delta(ST_ENTITY, ent, &baseline.edicts[i]);
+                    continue;
+                }
+                bin_write_u8(0);
+            }
+            bin_write_fields(ST_ENTITY, ent);
+        }
+        bin_write_u32(BIN_END_OF_LIST);
+
+        bin_finish_write(filename, delta ? SAVE_MAGIC2_DELTA : SAVE_MAGIC2_BIN);
+        return;
+    }
 
     memset(&block, 0, sizeof(block));
-    gzprintf(fp, SAVE_MAGIC2 " version %d\n", SAVE_VERSION_CURRENT);
+    text_printf(SAVE_MAGIC2 " version %d\n", SAVE_VERSION_CURRENT);
 
     // write out level_locals_t
     write_fields("level", levelfields, q_countof(levelfields), &level);
@@ -1741,10 +3483,7 @@ void WriteLevel(const char *filename)
     }
     end_block();
 
-    i = gzclose(fp);
-    fp = NULL;
-    if (i)
-        gi.error("Couldn't write %s", filename);
+    queue_save(filename, "wb", &text, 1);
 }
 
 /*
@@ -1769,6 +3508,13 @@ void ReadLevel(const char *filename)
     int     i;
     edict_t *ent;
 
+    save_format_t format = open_save(filename, SAVE_MAGIC2, SAVE_MAGIC2_BIN, SAVE_MAGIC2_DELTA);
+    bool binary = format != SAVE_TEXT;
+
+    // delta savegame applies on top of the level just spawned
+    if (format == SAVE_DELTA)
+        load_baseline(filename);
+
     // free any dynamic memory allocated by loading the level
     // base state
     gi.FreeTags(TAG_LEVEL);
@@ -1780,41 +3526,44 @@ void ReadLevel(const char *filename)
             *(char **)((byte *)&level + f->ofs) = NULL;
     }
 
-    fp = gzopen(filename, "rb");
-    if (!fp)
-        gi.error("Couldn't open %s", filename);
-
-    gzbuffer(fp, 65536);
-
-    memset(&line, 0, sizeof(line));
-    line.filename = COM_SkipPath(filename);
-    expect(SAVE_MAGIC2);
-    expect("version");
-    line.version = parse_int32();
-    if (line.version < SAVE_VERSION_MINIMUM || line.version > SAVE_VERSION_CURRENT)
-        gi.error("Savegame has bad version");
-
     // wipe all the entities
     memset(g_edicts, 0, game.maxentities * sizeof(g_edicts[0]));
     globals.num_edicts = game.maxclients + 1;
+    G_ClearThinkQueue();
+    G_InitEdictLists();
 
     // load the level locals
-    expect("level");
-    read_fields(levelfields, q_countof(levelfields), &level);
+    if (binary) {
+        bin_read_fields(ST_LEVEL, &level);
+    } else {
+        expect("level");
+        read_fields(ST_LEVEL, &level);
+        expect("entities");
+        expect("{");
+    }
 
     // load all the entities
-    expect("entities");
-    expect("{");
-    while ((entnum = parse_array(game.maxentities)) != -1) {
+    while ((entnum = binary ? bin_read_array(game.maxentities) : parse_array(game.maxentities)) != -1) {
         if (entnum >= globals.num_edicts)
             globals.num_edicts = entnum + 1;
 
         ent = &g_edicts[entnum];
-        if (ent->inuse)
+        if (ent->inuse) {
+            if (binary)
+                bin_error("duplicate entity: %d", entnum);
             parse_error("duplicate entity: %d", entnum);
+        }
 
         G_InitEdict(ent);
-        read_fields(entityfields, q_countof(entityfields), ent);
+        if (format == SAVE_DELTA && *bin_read_data(1)) {
+            if (entnum >= baseline.num_edicts || !baseline.edicts[entnum].inuse)
+                bin_error("no baseline for entity: %d", entnum);
+            copy_fields(ST_ENTITY, ent, &baseline.edicts[entnum]);
+        }
+        if (binary)
+            bin_read_fields(ST_ENTITY, ent);
+        else
+            read_fields(ST_ENTITY, ent);
 
         if (line.version < SAVE_VERSION_PSX) {
             if (ent->svflags & SVF_MONSTER)
@@ -1827,8 +3576,12 @@ void ReadLevel(const char *filename)
         gi.linkentity(ent);
     }
 
-    gzclose(fp);
-    fp = NULL;
+    if (binary)
+        bin_finish_read();
+    else
+        text_finish_read();
+
+    G_InitEdictLists();
 
     // mark all clients as unconnected
     for (i = 0; i < game.maxclients; i++) {
@@ -1850,7 +3603,7 @@ void ReadLevel(const char *filename)
         // fire any cross-level triggers
         if (strcmp(ent->classname, "target_crosslevel_target") == 0 ||
             strcmp(ent->classname, "target_crossunit_target") == 0)
-            ent->nextthink = level.time + SEC(ent->delay);
+            G_SetNextThink(ent, level.time + SEC(ent->delay));
     }
 
     // precache player inventory items
@@ -1863,10 +3616,18 @@ void ReadLevel(const char *filename)
 // clean up if error was thrown mid-save
 void G_CleanupSaves(void)
 {
+    wait_saves(false);
+
     if (fp) {
         gzclose(fp);
         fp = NULL;
     }
+
+    gi.FreeTags(TAG_SAVE);
+    memset(&line, 0, sizeof(line));
+    memset(&text, 0, sizeof(text));
+    memset(&bin, 0, sizeof(bin));
+    memset(&bin_in, 0, sizeof(bin_in));
 }
 
 // [Paril-KEX]
@@ -606,6 +606,14 @@ static const spawn_field_t temp_fields[] = {
 static byte entity_bitmap[(q_countof(entity_fields) + 7) / 8];
 static byte temp_bitmap[(q_countof(temp_fields) + 7) / 8];
 
+static uint16_t    entity_slots[256];
+static uint16_t    temp_slots[128];
+static name_hash_t entity_hash;
+static name_hash_t temp_hash;
+
+static uint16_t    spawn_slots[512];
+static name_hash_t spawn_hash;
+
 /*
 ===============
 ED_CallSpawn
@@ -625,6 +633,8 @@ void ED_CallSpawn(edict_t *ent)
         return;
     }
 
+    G_LinkTargetname(ent);
+
     // PGM - do this before calling the spawn function so it can be overridden.
     VectorSet(ent->gravityVector, 0, 0, -1);
     // PGM
@@ -639,41 +649,39 @@ void ED_CallSpawn(edict_t *ent)
     // pmm
 
     // check item spawn functions
-    for (i = 0, item = itemlist; i < IT_TOTAL; i++, item++) {
-        if (!item->classname)
-            continue;
-        if (!strcmp(item->classname, ent->classname)) {
-            // found it
-            // before spawning, pick random item replacement
-            if (g_dm_random_items->integer) {
-                ent->item = item;
-                item_id_t new_item = DoRandomRespawn(ent);
-
-                if (new_item) {
-                    item = GetItemByIndex(new_item);
-                    ent->classname = item->classname;
-                }
+    item = FindItemByClassname(ent->classname);
+    if (item && !strcmp(item->classname, ent->classname)) {
+        // found it
+        // before spawning, pick random item replacement
+        if (g_dm_random_items->integer) {
+            ent->item = item;
+            item_id_t new_item = DoRandomRespawn(ent);
+
+            if (new_item) {
+                item = GetItemByIndex(new_item);
+                ent->classname = item->classname;
             }
+        }
 
-            if (level.is_psx)
-                ent->s.origin[2] += 15 * (1 - PSX_PHYSICS_SCALAR);
+        if (level.is_psx)
+            ent->s.origin[2] += 15 * (1 - PSX_PHYSICS_SCALAR);
 
-            SpawnItem(ent, item);
-            return;
-        }
+        SpawnItem(ent, item);
+        return;
     }
 
     // check normal spawn functions
-    for (s = spawn_funcs; s->name; s++) {
-        if (!strcmp(s->name, ent->classname)) {
-            // found it
-            s->spawn(ent);
-
-            // Paril: swap classname with stored constant if we didn't change it
-            if (strcmp(ent->classname, s->name) == 0)
-                ent->classname = s->name;
-            return;
-        }
+    i = G_FindName(&spawn_hash, ent->classname);
+    if (i != -1 && !strcmp(spawn_funcs[i].name, ent->classname)) {
+        s = &spawn_funcs[i];
+
+        // found it
+        s->spawn(ent);
+
+        // Paril: swap classname with stored constant if we didn't change it
+        if (strcmp(ent->classname, s->name) == 0)
+            ent->classname = s->name;
+        return;
     }
 
     gi.dprintf("%s doesn't have a spawn function\n", etos(ent));
@@ -824,22 +832,19 @@ void ED_ParseField(const char *key, const char *value, edict_t *ent)
         return;
 
     // check st first
-    for (i = 0, f = temp_fields; i < q_countof(temp_fields); i++, f++) {
-        if (Q_strcasecmp(f->name, key))
-            continue;
-
+    i = G_FindName(&temp_hash, key);
+    if (i != -1) {
         Q_SetBit(temp_bitmap, i);
 
         // found it
-        ED_LoadField(f, value, (byte *)&st);
+        ED_LoadField(&temp_fields[i], value, (byte *)&st);
         return;
     }
 
     // now entity
-    for (i = 0, f = entity_fields; i < q_countof(entity_fields); i++, f++) {
-        if (Q_strcasecmp(f->name, key))
-            continue;
-
+    i = G_FindName(&entity_hash, key);
+    if (i != -1) {
+        f = &entity_fields[i];
         Q_SetBit(entity_bitmap, i);
 
         // [Paril-KEX]
@@ -856,42 +861,53 @@ void ED_ParseField(const char *key, const char *value, edict_t *ent)
 
 bool ED_WasKeySpecified(const char *key)
 {
-    const spawn_field_t *f;
     int i;
 
     // check st first
-    for (i = 0, f = temp_fields; i < q_countof(temp_fields); i++, f++)
-        if (!strcmp(f->name, key))
-            return Q_IsBitSet(temp_bitmap, i);
+    i = G_FindName(&temp_hash, key);
+    if (i != -1 && !strcmp(temp_fields[i].name, key))
+        return Q_IsBitSet(temp_bitmap, i);
 
     // now entity
-    for (i = 0, f = entity_fields; i < q_countof(entity_fields); i++, f++)
-        if (!strcmp(f->name, key))
-            return Q_IsBitSet(entity_bitmap, i);
+    i = G_FindName(&entity_hash, key);
+    if (i != -1 && !strcmp(entity_fields[i].name, key))
+        return Q_IsBitSet(entity_bitmap, i);
 
     return false;
 }
 
 void ED_SetKeySpecified(const char *key)
 {
-    const spawn_field_t *f;
     int i;
 
     // check st first
-    for (i = 0, f = temp_fields; i < q_countof(temp_fields); i++, f++) {
-        if (!strcmp(f->name, key)) {
-            Q_SetBit(temp_bitmap, i);
-            return;
-        }
+    i = G_FindName(&temp_hash, key);
+    if (i != -1 && !strcmp(temp_fields[i].name, key)) {
+        Q_SetBit(temp_bitmap, i);
+        return;
     }
 
     // now entity
-    for (i = 0, f = entity_fields; i < q_countof(entity_fields); i++, f++) {
-        if (!strcmp(f->name, key)) {
-            Q_SetBit(entity_bitmap, i);
-            return;
-        }
-    }
+    i = G_FindName(&entity_hash, key);
+    if (i != -1 && !strcmp(entity_fields[i].name, key))
+        Q_SetBit(entity_bitmap, i);
+}
+
+/*
+===============
+ED_InitSpawnHashes
+
+Builds name hashes for spawn function and spawn key lookups.
+===============
+*/
+void ED_InitSpawnHashes(void)
+{
+    G_InitNameHash(&spawn_hash, spawn_slots, q_countof(spawn_slots), spawn_funcs,
+                   sizeof(spawn_func_t), q_offsetof(spawn_func_t, name), q_countof(spawn_funcs) - 1);
+    G_InitNameHash(&temp_hash, temp_slots, q_countof(temp_slots), temp_fields,
+                   sizeof(spawn_field_t), q_offsetof(spawn_field_t, name), q_countof(temp_fields));
+    G_InitNameHash(&entity_hash, entity_slots, q_countof(entity_slots), entity_fields,
+                   sizeof(spawn_field_t), q_offsetof(spawn_field_t, name), q_countof(entity_fields));
 }
 
 void ED_InitSpawnVars(void)
@@ -957,8 +973,10 @@ static const char *ED_ParseEdict(const char *data, edict_t *ent)
         ED_ParseField(keyname, com_token, ent);
     }
 
-    if (!init)
+    if (!init) {
+        G_FreeEdict(ent);
         memset(ent, 0, sizeof(*ent));
+    }
 
     return data;
 }
@@ -1203,6 +1221,7 @@ void SpawnEntities(const char *mapname, const char *entities, const char *spawnp
     edict_t *ent;
     int      inhibit;
     const char   *com_token;
+    bool     baseline;
 
     int skill_level = Q_clip(skill->integer, 0, 3);
     if (skill->integer != skill_level)
@@ -1212,12 +1231,20 @@ void SpawnEntities(const char *mapname, const char *entities, const char *spawnp
 
     gi.FreeTags(TAG_LEVEL);
 
+    baseline = G_BeginBaseline(mapname);
+
     Nav_Unload();
 
     G_FreePrecaches();
 
     memset(&level, 0, sizeof(level));
     memset(g_edicts, 0, game.maxentities * sizeof(g_edicts[0]));
+    // slots of the previous level would otherwise be reused first,
+    // numbering baseline entities differently each time
+    if (baseline)
+        globals.num_edicts = game.maxclients + 1;
+    G_ClearThinkQueue();
+    G_InitEdictLists();
     level.is_spawning = true;
 
     // all other flags are not important atm
@@ -1313,6 +1340,8 @@ void SpawnEntities(const char *mapname, const char *entities, const char *spawnp
     }
     // ROGUE
 
+    G_EndBaseline();
+
     level.is_spawning = false;
 }
 
@@ -243,6 +243,16 @@ static void SVCmd_TestNav_f(void)
     fs->FreeFileList(list);
 }
 
+static void SVCmd_BenchNav_f(void)
+{
+    int count = 1000;
+
+    if (gi.argc() > 2)
+        count = Q_atoi(gi.argv(2));
+
+    Nav_Benchmark(count);
+}
+
 /*
 =================
 SV_WriteIP_f
@@ -315,6 +325,10 @@ void ServerCommand(void)
         SVCmd_NextMap_f();
     else if (Q_strcasecmp(cmd, "testnav") == 0)
         SVCmd_TestNav_f();
+    else if (Q_strcasecmp(cmd, "benchnav") == 0)
+        SVCmd_BenchNav_f();
+    else if (Q_strcasecmp(cmd, "navstats") == 0)
+        Nav_PrintStats();
     else
         gi.cprintf(NULL, PRINT_HIGH, "Unknown server command \"%s\"\n", cmd);
 }
@@ -199,7 +199,7 @@ void SP_target_secret(edict_t *ent)
     }
 
     ent->think = G_VerifyTargetted;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 
     ent->use = use_target_secret;
     if (!st.noise)
@@ -376,7 +376,7 @@ void USE(use_target_explosion)(edict_t *self, edict_t *other, edict_t *activator
     }
 
     self->think = target_explosion_explode;
-    self->nextthink = level.time + SEC(self->delay);
+    G_SetNextThink(self, level.time + SEC(self->delay));
 }
 
 void SP_target_explosion(edict_t *ent)
@@ -643,7 +643,7 @@ void SP_target_crosslevel_target(edict_t *self)
     self->svflags = SVF_NOCLIENT;
 
     self->think = target_crosslevel_target_think;
-    self->nextthink = level.time + SEC(self->delay);
+    G_SetNextThink(self, level.time + SEC(self->delay));
 }
 
 //==========================================================
@@ -737,7 +737,7 @@ void THINK(target_laser_think)(edict_t *self)
     if (damaged_thing)
         self->damage_debounce_time = level.time + HZ(10);
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     gi.linkentity(self);
 }
 
@@ -748,6 +748,7 @@ static void target_laser_on(edict_t *self)
     self->spawnflags |= SPAWNFLAG_LASER_ZAP | SPAWNFLAG_LASER_ON;
     self->svflags &= ~SVF_NOCLIENT;
     self->flags |= FL_TRAP;
+    G_RegisterTrap(self);
     target_laser_think(self);
 }
 
@@ -756,7 +757,7 @@ void target_laser_off(edict_t *self)
     self->spawnflags &= ~SPAWNFLAG_LASER_ON;
     self->svflags |= SVF_NOCLIENT;
     self->flags &= ~FL_TRAP;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
 }
 
 void USE(target_laser_use)(edict_t *self, edict_t *other, edict_t *activator)
@@ -813,7 +814,7 @@ void THINK(target_laser_start)(edict_t *self)
 
     if (!self->enemy)  {
         if (self->target) {
-            ent = G_Find(NULL, FOFS(targetname), self->target);
+            ent = G_FindByTargetname(NULL, self->target);
             if (!ent)
                 gi.dprintf("%s: %s is a bad target\n", etos(self), self->target);
             else {
@@ -860,7 +861,8 @@ void SP_target_laser(edict_t *self)
     // let everything else get spawned before we start firing
     self->think = target_laser_start;
     self->flags |= FL_TRAP_LASER_FIELD;
-    self->nextthink = level.time + SEC(1);
+    G_RegisterTrap(self);
+    G_SetNextThink(self, level.time + SEC(1));
 }
 
 //==========================================================
@@ -883,7 +885,7 @@ void THINK(target_lightramp_think)(edict_t *self)
     gi.configstring(CS_LIGHTS + self->enemy->style, style);
 
     if (diff < self->speed) {
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     } else if (self->spawnflags & SPAWNFLAG_LIGHTRAMP_TOGGLE) {
         SWAP(float, self->movedir[0], self->movedir[1]);
         self->movedir[2] = -self->movedir[2];
@@ -898,7 +900,7 @@ void USE(target_lightramp_use)(edict_t *self, edict_t *other, edict_t *activator
         // check all the targets
         e = NULL;
         while (1) {
-            e = G_Find(e, FOFS(targetname), self->target);
+            e = G_FindByTargetname(e, self->target);
             if (!e)
                 break;
             if (strcmp(e->classname, "light") != 0)
@@ -981,7 +983,7 @@ void THINK(target_earthquake_think)(edict_t *self)
     }
 
     if (level.time < self->timestamp)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
 }
 
 void USE(target_earthquake_use)(edict_t *self, edict_t *other, edict_t *activator)
@@ -1004,13 +1006,13 @@ void USE(target_earthquake_use)(edict_t *self, edict_t *other, edict_t *activato
 
     if (self->spawnflags & SPAWNFLAGS_EARTHQUAKE_TOGGLE) {
         if (self->style)
-            self->nextthink = 0;
+            G_SetNextThink(self, 0);
         else
-            self->nextthink = level.time + FRAME_TIME;
+            G_SetNextThink(self, level.time + FRAME_TIME);
 
         self->style = !self->style;
     } else {
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
         self->last_move_time = 0;
     }
 
@@ -1080,7 +1082,7 @@ void THINK(update_target_camera)(edict_t *self)
             }
 
             VectorCopy(self->movetarget->s.origin, self->s.origin);
-            self->nextthink = level.time + SEC(self->movetarget->wait);
+            G_SetNextThink(self, level.time + SEC(self->movetarget->wait));
             if (self->movetarget->target) {
                 self->movetarget = G_PickTarget(self->movetarget->target);
 
@@ -1105,7 +1107,7 @@ void THINK(update_target_camera)(edict_t *self)
         VectorMA(self->s.origin, frac, delta, newpos);
 
         if (self->pathtarget) {
-            edict_t *pt = G_Find(NULL, FOFS(targetname), self->pathtarget);
+            edict_t *pt = G_FindByTargetname(NULL, self->pathtarget);
             if (pt) {
                 VectorSubtract(pt->s.origin, newpos, delta);
                 vectoangles(delta, level.intermission_angle);
@@ -1130,8 +1132,10 @@ void THINK(update_target_camera)(edict_t *self)
             level.intermissiontime = 0;
             level.level_intermission_set = true;
 
-            while ((t = G_Find(t, FOFS(targetname), self->killtarget)))
+            while ((t = G_FindByTargetname(t, self->killtarget))) {
+                G_WakeEntity(t);
                 t->use(t, self, self->activator);
+            }
 
             level.intermissiontime = level.time;
             //level.intermission_server_frame = gi.ServerFrame();
@@ -1145,7 +1149,7 @@ void THINK(update_target_camera)(edict_t *self)
         return;
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void G_SetClientFrame(edict_t *ent);
@@ -1168,7 +1172,7 @@ void THINK(target_camera_dummy_think)(edict_t *self)
         self->x.alpha = max(1.0f / 255, frac);
     }
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void USE(use_target_camera)(edict_t *self, edict_t *other, edict_t *activator)
@@ -1197,7 +1201,7 @@ void USE(use_target_camera)(edict_t *self, edict_t *other, edict_t *activator)
         dummy->groundentity = activator->groundentity;
         dummy->groundentity_linkcount = dummy->groundentity ? dummy->groundentity->linkcount : 0;
         dummy->think = target_camera_dummy_think;
-        dummy->nextthink = level.time + HZ(10);
+        G_SetNextThink(dummy, level.time + HZ(10));
         dummy->solid = SOLID_BBOX;
         dummy->movetype = MOVETYPE_STEP;
         VectorCopy(activator->mins, dummy->mins);
@@ -1211,7 +1215,7 @@ void USE(use_target_camera)(edict_t *self, edict_t *other, edict_t *activator)
     }
 
     if (self->pathtarget) {
-        edict_t *pt = G_Find(NULL, FOFS(targetname), self->pathtarget);
+        edict_t *pt = G_FindByTargetname(NULL, self->pathtarget);
         if (pt) {
             vec3_t delta;
             VectorSubtract(pt->s.origin, self->s.origin, delta);
@@ -1243,7 +1247,7 @@ void USE(use_target_camera)(edict_t *self, edict_t *other, edict_t *activator)
 
     self->activator = activator;
     self->think = update_target_camera;
-    self->nextthink = level.time + SEC(self->wait);
+    G_SetNextThink(self, level.time + SEC(self->wait));
     self->moveinfo.move_speed = self->speed;
 
     self->moveinfo.remaining_distance = Distance(self->movetarget->s.origin, self->s.origin);
@@ -1293,7 +1297,7 @@ void THINK(update_target_soundfx)(edict_t *self)
 void USE(use_target_soundfx)(edict_t *self, edict_t *other, edict_t *activator)
 {
     self->think = update_target_soundfx;
-    self->nextthink = level.time + SEC(self->delay);
+    G_SetNextThink(self, level.time + SEC(self->delay));
 }
 
 void SP_target_soundfx(edict_t *self)
@@ -1346,7 +1350,7 @@ void THINK(target_light_flicker_think)(edict_t *self)
     if (brandom())
         self->svflags ^= SVF_NOCLIENT;
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 // think function handles interpolation from start to finish.
@@ -1388,7 +1392,7 @@ void THINK(target_light_think)(edict_t *self)
 
     self->s.skinnum = MakeBigLong(r, g, b, 0);
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void USE(target_light_use)(edict_t *self, edict_t *other, edict_t *activator)
@@ -1402,17 +1406,17 @@ void USE(target_light_use)(edict_t *self, edict_t *other, edict_t *activator)
 
     if (!self->health) {
         self->think = NULL;
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
         return;
     }
 
     // has dynamic light "target"
     if (self->chain) {
         self->think = target_light_think;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     } else if (self->spawnflags & SPAWNFLAG_TARGET_LIGHT_FLICKER) {
         self->think = target_light_flicker_think;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     }
 }
 
@@ -1509,7 +1513,7 @@ void SP_target_poi(edict_t *self)
     self->use = target_poi_use;
     self->svflags |= SVF_NOCLIENT;
     self->think = target_poi_setup;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     if (!self->team) {
         if (self->spawnflags & SPAWNFLAG_POI_NEAREST)
@@ -1603,7 +1607,7 @@ void SP_target_healthbar(edict_t *self)
 
     self->use = use_target_healthbar;
     self->think = check_target_healthbar;
-    self->nextthink = level.time + SEC(0.025f);
+    G_SetNextThink(self, level.time + SEC(0.025f));
 }
 
 /*QUAKED target_autosave (0 1 0) (-8 -8 -8) (8 8 8)
@@ -1725,7 +1729,7 @@ void SP_target_crossunit_target(edict_t *self)
     self->svflags = SVF_NOCLIENT;
 
     self->think = target_crossunit_target_think;
-    self->nextthink = level.time + SEC(self->delay);
+    G_SetNextThink(self, level.time + SEC(self->delay));
 }
 
 /*QUAKED target_achievement (.5 .5 .5) (-8 -8 -8) (8 8 8)
@@ -0,0 +1,296 @@
+// Copyright (c) ZeniMax Media Inc.
+// Licensed under the GNU General Public License 2.0.
+// g_threads.c -- worker threads for parallel load-time work
+
+#include "g_local.h"
+
+/*
+==============================================================================
+
+WORKER POOL
+
+G_RunJobs calls func(arg, index, worker) for each index in [0, count) and
+returns once all jobs are finished. Jobs are spread over g_workers extra
+threads, the calling thread takes part as worker 0. Jobs must not call any
+game import functions, and should only write memory that belongs to their
+index or worker.
+
+G_RunBackground queues a single job on a dedicated background thread and
+returns immediately. Background jobs run one at a time in the order they were
+queued, under the same restrictions as G_RunJobs. G_WaitBackground blocks
+until all queued background jobs are finished.
+
+==============================================================================
+*/
+
+#define MAX_WORKERS     16
+#define MAX_BACKGROUND  16
+
+static cvar_t *g_workers;
+
+#if USE_THREADS
+
+#include <pthread.h>
+
+static struct {
+    pthread_t       threads[MAX_WORKERS];
+    int             num_threads;
+    bool            quit;
+
+    pthread_mutex_t lock;
+    pthread_cond_t  work_cond;
+    pthread_cond_t  done_cond;
+
+    // current batch, protected by lock
+    job_func_t      func;
+    void            *arg;
+    int             next, count;
+    int             pending;
+} pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work_cond = PTHREAD_COND_INITIALIZER,
+    .done_cond = PTHREAD_COND_INITIALIZER,
+};
+
+// runs jobs of current batch until none are left, called with lock held
+static void G_WorkOnBatch(int worker)
+{
+    while (pool.next < pool.count) {
+        job_func_t func = pool.func;
+        void *arg = pool.arg;
+        int index = pool.next++;
+
+        pthread_mutex_unlock(&pool.lock);
+        func(arg, index, worker);
+        pthread_mutex_lock(&pool.lock);
+
+        if (!--pool.pending)
+            pthread_cond_signal(&pool.done_cond);
+    }
+}
+
+static void *G_WorkerThread(void *arg)
+{
+    int worker = (intptr_t)arg;
+
+    pthread_mutex_lock(&pool.lock);
+    while (1) {
+        while (!pool.quit && pool.next >= pool.count)
+            pthread_cond_wait(&pool.work_cond, &pool.lock);
+        if (pool.quit)
+            break;
+        G_WorkOnBatch(worker);
+    }
+    pthread_mutex_unlock(&pool.lock);
+
+    return NULL;
+}
+
+static void G_StopWorkers(void)
+{
+    if (!pool.num_threads)
+        return;
+
+    pthread_mutex_lock(&pool.lock);
+    pool.quit = true;
+    pthread_cond_broadcast(&pool.work_cond);
+    pthread_mutex_unlock(&pool.lock);
+
+    for (int i = 0; i < pool.num_threads; i++)
+        pthread_join(pool.threads[i], NULL);
+
+    pool.num_threads = 0;
+    pool.quit = false;
+}
+
+static void G_StartWorkers(void)
+{
+    int count = Q_clip(g_workers->integer, 0, MAX_WORKERS - 1);
+
+    if (count == pool.num_threads)
+        return;
+
+    G_StopWorkers();
+
+    for (int i = 0; i < count; i++) {
+        if (pthread_create(&pool.threads[i], NULL, G_WorkerThread, (void *)(intptr_t)(i + 1))) {
+            gi.dprintf("Couldn't create worker thread\n");
+            break;
+        }
+        pool.num_threads++;
+    }
+}
+
+/*
+=============
+G_NumWorkers
+
+Returns maximum number of workers a following G_RunJobs call will use.
+=============
+*/
+int G_NumWorkers(void)
+{
+    G_StartWorkers();
+    return pool.num_threads + 1;
+}
+
+void G_RunJobs(job_func_t func, void *arg, int count)
+{
+    G_StartWorkers();
+
+    if (!pool.num_threads || count < 2) {
+        for (int i = 0; i < count; i++)
+            func(arg, i, 0);
+        return;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+
+    pool.func = func;
+    pool.arg = arg;
+    pool.next = 0;
+    pool.count = count;
+    pool.pending = count;
+    pthread_cond_broadcast(&pool.work_cond);
+
+    G_WorkOnBatch(0);
+
+    while (pool.pending)
+        pthread_cond_wait(&pool.done_cond, &pool.lock);
+
+    pool.next = pool.count = 0;
+    pool.func = NULL;
+    pool.arg = NULL;
+
+    pthread_mutex_unlock(&pool.lock);
+}
+
+static struct {
+    pthread_t       thread;
+    bool            started;
+    bool            quit;
+
+    pthread_mutex_t lock;
+    pthread_cond_t  work_cond;
+    pthread_cond_t  done_cond;
+
+    // queued jobs, protected by lock
+    job_func_t      funcs[MAX_BACKGROUND];
+    void            *args[MAX_BACKGROUND];
+    unsigned        head, tail;
+} bg = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work_cond = PTHREAD_COND_INITIALIZER,
+    .done_cond = PTHREAD_COND_INITIALIZER,
+};
+
+static void *G_BackgroundThread(void *unused)
+{
+    pthread_mutex_lock(&bg.lock);
+    while (1) {
+        while (!bg.quit && bg.head == bg.tail)
+            pthread_cond_wait(&bg.work_cond, &bg.lock);
+        if (bg.head == bg.tail)
+            break;
+
+        unsigned i = bg.tail % MAX_BACKGROUND;
+        job_func_t func = bg.funcs[i];
+        void *arg = bg.args[i];
+
+        pthread_mutex_unlock(&bg.lock);
+        func(arg, 0, 0);
+        pthread_mutex_lock(&bg.lock);
+
+        bg.tail++;
+        pthread_cond_broadcast(&bg.done_cond);
+    }
+    pthread_mutex_unlock(&bg.lock);
+
+    return NULL;
+}
+
+void G_RunBackground(job_func_t func, void *arg)
+{
+    if (!bg.started) {
+        if (pthread_create(&bg.thread, NULL, G_BackgroundThread, NULL)) {
+            gi.dprintf("Couldn't create background thread\n");
+            func(arg, 0, 0);
+            return;
+        }
+        bg.started = true;
+    }
+
+    pthread_mutex_lock(&bg.lock);
+    while (bg.head - bg.tail == MAX_BACKGROUND)
+        pthread_cond_wait(&bg.done_cond, &bg.lock);
+
+    bg.funcs[bg.head % MAX_BACKGROUND] = func;
+    bg.args[bg.head % MAX_BACKGROUND] = arg;
+    bg.head++;
+    pthread_cond_signal(&bg.work_cond);
+    pthread_mutex_unlock(&bg.lock);
+}
+
+void G_WaitBackground(void)
+{
+    pthread_mutex_lock(&bg.lock);
+    while (bg.head != bg.tail)
+        pthread_cond_wait(&bg.done_cond, &bg.lock);
+    pthread_mutex_unlock(&bg.lock);
+}
+
+// finishes queued jobs and stops background thread
+static void G_StopBackground(void)
+{
+    if (!bg.started)
+        return;
+
+    pthread_mutex_lock(&bg.lock);
+    bg.quit = true;
+    pthread_cond_signal(&bg.work_cond);
+    pthread_mutex_unlock(&bg.lock);
+
+    pthread_join(bg.thread, NULL);
+
+    bg.started = false;
+    bg.quit = false;
+}
+
+void G_ShutdownThreads(void)
+{
+    G_StopWorkers();
+    G_StopBackground();
+}
+
+#else
+
+int G_NumWorkers(void)
+{
+    return 1;
+}
+
+void G_RunJobs(job_func_t func, void *arg, int count)
+{
+    for (int i = 0; i < count; i++)
+        func(arg, i, 0);
+}
+
+void G_RunBackground(job_func_t func, void *arg)
+{
+    func(arg, 0, 0);
+}
+
+void G_WaitBackground(void)
+{
+}
+
+void G_ShutdownThreads(void)
+{
+}
+
+#endif
+
+void G_InitThreads(void)
+{
+    g_workers = gi.cvar("g_workers", "4", 0);
+}
@@ -28,7 +28,7 @@ static void InitTrigger(edict_t *self)
 // the wait time has passed, so set back up for another activation
 void THINK(multi_wait)(edict_t *ent)
 {
-    ent->nextthink = 0;
+    G_SetNextThink(ent, 0);
 }
 
 // the trigger was just activated
@@ -43,12 +43,12 @@ static void multi_trigger(edict_t *ent)
 
     if (ent->wait > 0) {
         ent->think = multi_wait;
-        ent->nextthink = level.time + SEC(ent->wait);
+        G_SetNextThink(ent, level.time + SEC(ent->wait));
     } else {
         // we can't just remove (self) here, because this is a touch function
         // called while looping through area links...
         ent->touch = NULL;
-        ent->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(ent, level.time + FRAME_TIME);
         ent->think = G_FreeEdict;
     }
 }
@@ -122,7 +122,7 @@ void USE(trigger_enable)(edict_t *self, edict_t *other, edict_t *activator)
 
 void THINK(latched_trigger_think)(edict_t *self)
 {
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     edict_t *list[MAX_EDICTS_OLD];
     int count = gi.BoxEdicts(self->absmin, self->absmax, list, q_countof(list), AREA_SOLID);
@@ -181,7 +181,7 @@ void SP_trigger_multiple(edict_t *ent)
             gi.dprintf("%s: latched and triggered/toggle are not supported\n", etos(ent));
 
         ent->think = latched_trigger_think;
-        ent->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(ent, level.time + FRAME_TIME);
         ent->use = Use_Multi;
         return;
     }
@@ -531,11 +531,11 @@ static void trigger_effect(edict_t *self)
 void THINK(trigger_push_inactive)(edict_t *self)
 {
     if (self->timestamp > level.time) {
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     } else {
         self->touch = trigger_push_touch;
         self->think = trigger_push_active;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
         self->timestamp = self->nextthink + SEC(self->wait);
     }
 }
@@ -543,12 +543,12 @@ void THINK(trigger_push_inactive)(edict_t *self)
 void THINK(trigger_push_active)(edict_t *self)
 {
     if (self->timestamp > level.time) {
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
         trigger_effect(self);
     } else {
         self->touch = NULL;
         self->think = trigger_push_inactive;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
         self->timestamp = self->nextthink + SEC(self->wait);
     }
 }
@@ -577,7 +577,7 @@ void SP_trigger_push(edict_t *self)
             self->wait = 10;
 
         self->think = trigger_push_active;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
         self->timestamp = self->nextthink + SEC(self->wait);
     }
     // RAFAEL
@@ -650,11 +650,11 @@ void USE(hurt_use)(edict_t *self, edict_t *other, edict_t *activator)
     if (self->spawnflags & SPAWNFLAG_HURT_PASSIVE) {
         if (self->solid == SOLID_TRIGGER) {
             if (self->spawnflags & SPAWNFLAG_HURT_SLOW)
-                self->nextthink = level.time + SEC(1);
+                G_SetNextThink(self, level.time + SEC(1));
             else
-                self->nextthink = level.time + HZ(10);
+                G_SetNextThink(self, level.time + HZ(10));
         } else
-            self->nextthink = 0;
+            G_SetNextThink(self, 0);
     }
 }
 
@@ -710,9 +710,9 @@ void THINK(hurt_think)(edict_t *self)
     }
 
     if (self->spawnflags & SPAWNFLAG_HURT_SLOW)
-        self->nextthink = level.time + SEC(1);
+        G_SetNextThink(self, level.time + SEC(1));
     else
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
 }
 
 void TOUCH(hurt_touch)(edict_t *self, edict_t *other, const trace_t *tr, bool other_touching_self)
@@ -756,9 +756,9 @@ void SP_trigger_hurt(edict_t *self)
 
         if (!(self->spawnflags & SPAWNFLAG_HURT_START_OFF)) {
             if (self->spawnflags & SPAWNFLAG_HURT_SLOW)
-                self->nextthink = level.time + SEC(1);
+                G_SetNextThink(self, level.time + SEC(1));
             else
-                self->nextthink = level.time + HZ(10);
+                G_SetNextThink(self, level.time + HZ(10));
         }
     } else
         self->touch = hurt_touch;
@@ -1234,7 +1234,7 @@ void THINK(trigger_coop_relay_think)(edict_t *self)
         self->timestamp = level.time + SEC(5);
     }
 
-    self->nextthink = level.time + SEC(self->wait);
+    G_SetNextThink(self, level.time + SEC(self->wait));
 }
 
 void SP_trigger_coop_relay(edict_t *self)
@@ -1255,7 +1255,7 @@ void SP_trigger_coop_relay(edict_t *self)
 
     if (self->spawnflags & SPAWNFLAG_COOP_RELAY_AUTO_FIRE) {
         self->think = trigger_coop_relay_think;
-        self->nextthink = level.time + SEC(self->wait);
+        G_SetNextThink(self, level.time + SEC(self->wait));
     } else
         self->use = trigger_coop_relay_use;
     self->svflags |= SVF_NOCLIENT;
@@ -150,7 +150,7 @@ void THINK(turret_breach_think)(edict_t *self)
 
     VectorScale(delta, 1.0f / FRAME_TIME_SEC, self->avelocity);
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     for (ent = self->teammaster; ent; ent = ent->teamchain)
         ent->avelocity[1] = self->avelocity[1];
@@ -248,7 +248,7 @@ void SP_turret_breach(edict_t *self)
     self->moveinfo.blocked = turret_blocked;
 
     self->think = turret_breach_finish_init;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     gi.linkentity(self);
 }
 
@@ -321,7 +321,7 @@ void THINK(turret_driver_think)(edict_t *self)
     vec3_t target;
     vec3_t dir;
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     if (self->enemy && (!self->enemy->inuse || self->enemy->health <= 0))
         self->enemy = NULL;
@@ -366,7 +366,7 @@ void THINK(turret_driver_link)(edict_t *self)
     edict_t *ent;
 
     self->think = turret_driver_think;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     self->target_ent = G_PickTarget(self->target);
     if (!self->target_ent) {
@@ -444,7 +444,7 @@ void SP_turret_driver(edict_t *self)
     }
 
     self->think = turret_driver_link;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     gi.linkentity(self);
 }
@@ -465,7 +465,7 @@ void THINK(turret_brain_think)(edict_t *self)
     vec3_t  dir;
     trace_t trace;
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     if (self->enemy) {
         if (!self->enemy->inuse)
@@ -522,7 +522,7 @@ void THINK(turret_brain_link)(edict_t *self)
         self->enemy = G_PickTarget(self->killtarget);
 
     self->think = turret_brain_think;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     self->target_ent = G_PickTarget(self->target);
     if (!self->target_ent) {
@@ -557,7 +557,7 @@ void THINK(turret_brain_link)(edict_t *self)
 void USE(turret_brain_deactivate)(edict_t *self, edict_t *other, edict_t *activator)
 {
     self->think = NULL;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
 }
 
 void USE(turret_brain_activate)(edict_t *self, edict_t *other, edict_t *activator)
@@ -577,7 +577,7 @@ void USE(turret_brain_activate)(edict_t *self, edict_t *other, edict_t *activato
     self->activator = activator;
 
     self->think = turret_brain_link;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 /*QUAKED turret_invisible_brain (1 .5 0) (-16 -16 -16) (16 16 16)
@@ -609,7 +609,7 @@ void SP_turret_invisible_brain(edict_t *self)
         self->use = turret_brain_activate;
     } else {
         self->think = turret_brain_link;
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     }
 
     self->movetype = MOVETYPE_PUSH;
@@ -86,6 +86,411 @@ edict_t *G_Find(edict_t *from, int fieldofs, const char *match)
     return NULL;
 }
 
+/*
+==============================================================================
+
+TARGETNAME INDEX
+
+Entities with a targetname are kept in hash chains sorted by entity number,
+so lookups return them in the same order G_Find would. The index is updated
+when entities are spawned and freed; entries whose targetname has changed
+since are filtered out on lookup.
+
+==============================================================================
+*/
+
+#define TARGETNAME_HASH_SIZE    1024
+
+static int  tn_hash[TARGETNAME_HASH_SIZE];  // entity number + 1, 0 if empty
+static int  tn_next[MAX_EDICTS];            // entity number + 1, 0 if last
+static int  tn_bucket[MAX_EDICTS];          // bucket + 1, 0 if not linked
+
+static unsigned G_HashTargetname(const char *s)
+{
+    unsigned hash = 0;
+
+    while (*s)
+        hash = hash * 37 + Q_tolower(*s++);
+
+    return hash & (TARGETNAME_HASH_SIZE - 1);
+}
+
+void G_UnlinkTargetname(edict_t *ent)
+{
+    int num = ent - g_edicts;
+    int *link;
+
+    if (!tn_bucket[num])
+        return;
+
+    link = &tn_hash[tn_bucket[num] - 1];
+    while (*link != num + 1)
+        link = &tn_next[*link - 1];
+    *link = tn_next[num];
+
+    tn_next[num] = 0;
+    tn_bucket[num] = 0;
+}
+
+/*
+=============
+G_LinkTargetname
+
+(Re)inserts entity into the targetname index. Must be called after
+targetname is changed for the entity to be found by G_FindByTargetname.
+=============
+*/
+void G_LinkTargetname(edict_t *ent)
+{
+    int num = ent - g_edicts;
+    unsigned bucket;
+    int *link;
+
+    G_UnlinkTargetname(ent);
+
+    if (!ent->inuse || !ent->targetname)
+        return;
+
+    bucket = G_HashTargetname(ent->targetname);
+    link = &tn_hash[bucket];
+    while (*link && *link - 1 < num)
+        link = &tn_next[*link - 1];
+
+    tn_next[num] = *link;
+    tn_bucket[num] = bucket + 1;
+    *link = num + 1;
+}
+
+static void G_InitTargetnames(void)
+{
+    memset(tn_hash, 0, sizeof(tn_hash));
+    memset(tn_next, 0, sizeof(tn_next));
+    memset(tn_bucket, 0, sizeof(tn_bucket));
+
+    for (int i = 0; i < globals.num_edicts; i++)
+        G_LinkTargetname(&g_edicts[i]);
+}
+
+/*
+=============
+G_FindByTargetname
+
+Same as G_Find(from, FOFS(targetname), match), but only visits entities
+in the matching hash chain.
+=============
+*/
+edict_t *G_FindByTargetname(edict_t *from, const char *match)
+{
+    int start = from ? from - g_edicts + 1 : 0;
+    edict_t *ent;
+
+    for (int i = tn_hash[G_HashTargetname(match)]; i; i = tn_next[i - 1]) {
+        if (i - 1 < start)
+            continue;
+        ent = &g_edicts[i - 1];
+        if (!ent->inuse || !ent->targetname)
+            continue;
+        if (!Q_stricmp(ent->targetname, match))
+            return ent;
+    }
+
+    return NULL;
+}
+
+/*
+==============================================================================
+
+NAME HASH
+
+Case insensitive open addressing hash over a static array of structures that
+have a name string at given offset, for replacing linear strcmp scans over
+field and spawn tables. Slots are provided by caller and must be a power of
+two at least twice the number of elements. Elements with NULL names are
+skipped. If several elements share a name, first one is found, same as with
+linear scan.
+
+==============================================================================
+*/
+
+static unsigned G_HashName(const char *s)
+{
+    unsigned hash = 0;
+
+    while (*s)
+        hash = hash * 37 + Q_tolower(*s++);
+
+    return hash;
+}
+
+static const char *G_HashedName(const name_hash_t *hash, int index)
+{
+    return *(const char **)(hash->base + index * hash->stride + hash->name_ofs);
+}
+
+void G_InitNameHash(name_hash_t *hash, uint16_t *slots, int num_slots,
+                    const void *base, size_t stride, size_t name_ofs, int count)
+{
+    Q_assert(!(num_slots & (num_slots - 1)));
+    Q_assert(count * 2 <= num_slots && count < UINT16_MAX);
+
+    hash->base = base;
+    hash->stride = stride;
+    hash->name_ofs = name_ofs;
+    hash->slots = slots;
+    hash->mask = num_slots - 1;
+
+    memset(slots, 0, num_slots * sizeof(slots[0]));
+
+    for (int i = 0; i < count; i++) {
+        const char *name = G_HashedName(hash, i);
+        unsigned j;
+
+        if (!name || G_FindName(hash, name) != -1)
+            continue;
+
+        for (j = G_HashName(name); slots[j & hash->mask]; j++)
+            ;
+        slots[j & hash->mask] = i + 1;
+    }
+}
+
+/*
+=============
+G_FindName
+
+Returns index of element with matching name, or -1 if not found.
+=============
+*/
+int G_FindName(const name_hash_t *hash, const char *name)
+{
+    int index;
+
+    for (unsigned j = G_HashName(name); (index = hash->slots[j & hash->mask]); j++)
+        if (!Q_strcasecmp(G_HashedName(hash, index - 1), name))
+            return index - 1;
+
+    return -1;
+}
+
+/*
+==============================================================================
+
+SPATIAL GRID
+
+Entity bounding boxes are hashed into a uniform grid of square cells on the
+XY plane each time the entity is linked. Entities spanning too many cells
+are kept in a separate set that is always returned. Queries return a bitmap
+of candidate entity numbers, so callers visit them in edict order. Entities
+are indexed at their last linked position, the same as the server's own
+area links.
+
+==============================================================================
+*/
+
+#define GRID_CELL_SHIFT     7       // 128 unit cells
+#define GRID_HASH_SIZE      4096
+#define GRID_MAX_SPAN       3       // wider entities go to the large set
+#define GRID_MAX_QUERY      32      // wider queries return everything
+#define GRID_MAX_NODES      (GRID_MAX_SPAN * GRID_MAX_SPAN)
+#define GRID_MAX_COORD      262144
+
+typedef struct {
+    int     x0, y0, x1, y1;
+} grid_bounds_t;
+
+static int              grid_hash[GRID_HASH_SIZE];                  // node + 1
+static int              grid_next[MAX_EDICTS * GRID_MAX_NODES];     // node + 1
+static grid_bounds_t    grid_bounds[MAX_EDICTS];
+static byte             grid_linked[MAX_EDICTS / 8];
+static byte             grid_large[MAX_EDICTS / 8];
+static unsigned         grid_version;
+
+static int G_GridCoord(float v)
+{
+    return (int)floorf(Q_clipf(v, -GRID_MAX_COORD, GRID_MAX_COORD)) >> GRID_CELL_SHIFT;
+}
+
+static unsigned G_GridHash(int x, int y)
+{
+    return ((unsigned)x * 73856093u ^ (unsigned)y * 19349663u) & (GRID_HASH_SIZE - 1);
+}
+
+static void G_GridBounds(const vec3_t mins, const vec3_t maxs, grid_bounds_t *b)
+{
+    // pad by a unit to stay on the safe side of float rounding
+    b->x0 = G_GridCoord(mins[0] - 1);
+    b->y0 = G_GridCoord(mins[1] - 1);
+    b->x1 = G_GridCoord(maxs[0] + 1);
+    b->y1 = G_GridCoord(maxs[1] + 1);
+}
+
+void G_GridUnlinkEntity(edict_t *ent)
+{
+    int num = ent - g_edicts;
+    const grid_bounds_t *b = &grid_bounds[num];
+    int x, y, node, *link;
+
+    if (!Q_IsBitSet(grid_linked, num))
+        return;
+
+    Q_ClearBit(grid_linked, num);
+    grid_version++;
+
+    if (Q_IsBitSet(grid_large, num)) {
+        Q_ClearBit(grid_large, num);
+        return;
+    }
+
+    node = num * GRID_MAX_NODES;
+    for (y = b->y0; y <= b->y1; y++) {
+        for (x = b->x0; x <= b->x1; x++, node++) {
+            link = &grid_hash[G_GridHash(x, y)];
+            while (*link != node + 1)
+                link = &grid_next[*link - 1];
+            *link = grid_next[node];
+        }
+    }
+}
+
+/*
+=============
+G_GridLinkEntity
+
+Called each time the entity is linked into the world.
+=============
+*/
+void G_GridLinkEntity(edict_t *ent)
+{
+    int num = ent - g_edicts;
+    grid_bounds_t b;
+    vec3_t mins, maxs;
+    int x, y, node;
+    unsigned hash;
+
+    VectorAdd(ent->s.origin, ent->mins, mins);
+    VectorAdd(ent->s.origin, ent->maxs, maxs);
+    G_GridBounds(mins, maxs, &b);
+
+    // most relinks don't cross cell boundaries
+    if (Q_IsBitSet(grid_linked, num) && !memcmp(&b, &grid_bounds[num], sizeof(b)))
+        return;
+
+    G_GridUnlinkEntity(ent);
+
+    Q_SetBit(grid_linked, num);
+    grid_bounds[num] = b;
+    grid_version++;
+
+    if (b.x1 - b.x0 >= GRID_MAX_SPAN || b.y1 - b.y0 >= GRID_MAX_SPAN) {
+        Q_SetBit(grid_large, num);
+        return;
+    }
+
+    node = num * GRID_MAX_NODES;
+    for (y = b.y0; y <= b.y1; y++) {
+        for (x = b.x0; x <= b.x1; x++, node++) {
+            hash = G_GridHash(x, y);
+            grid_next[node] = grid_hash[hash];
+            grid_hash[hash] = node + 1;
+        }
+    }
+}
+
+static void G_InitGrid(void)
+{
+    memset(grid_hash, 0, sizeof(grid_hash));
+    memset(grid_linked, 0, sizeof(grid_linked));
+    memset(grid_large, 0, sizeof(grid_large));
+    grid_version++;
+
+    for (int i = 0; i < globals.num_edicts; i++)
+        if (g_edicts[i].inuse)
+            G_GridLinkEntity(&g_edicts[i]);
+}
+
+/*
+=============
+G_BoxCandidates
+
+Sets bits for all entities that may be touching the given box. This is a
+superset, callers need to check the entities themselves.
+=============
+*/
+void G_BoxCandidates(const vec3_t mins, const vec3_t maxs, byte *bits)
+{
+    grid_bounds_t b;
+    int x, y, n;
+
+    G_GridBounds(mins, maxs, &b);
+
+    if (b.x1 - b.x0 >= GRID_MAX_QUERY || b.y1 - b.y0 >= GRID_MAX_QUERY) {
+        memset(bits, 255, MAX_EDICTS / 8);
+        return;
+    }
+
+    memcpy(bits, grid_large, MAX_EDICTS / 8);
+
+    // worldspawn is never linked
+    Q_SetBit(bits, 0);
+
+    for (y = b.y0; y <= b.y1; y++)
+        for (x = b.x0; x <= b.x1; x++)
+            for (n = grid_hash[G_GridHash(x, y)]; n; n = grid_next[n - 1])
+                Q_SetBit(bits, (n - 1) / GRID_MAX_NODES);
+}
+
+/*
+=============
+G_RadiusCandidates
+
+Returns candidate bitmap for a spherical area. The result of the last query
+is reused while the grid is unchanged, so findradius style loops only pay
+for it once.
+=============
+*/
+const byte *G_RadiusCandidates(const vec3_t org, float rad)
+{
+    static byte     bits[MAX_EDICTS / 8];
+    static vec3_t   last_org;
+    static float    last_rad;
+    static unsigned last_version;
+    vec3_t mins, maxs;
+
+    if (last_version == grid_version && last_rad == rad && VectorCompare(last_org, org))
+        return bits;
+
+    VectorSet(mins, org[0] - rad, org[1] - rad, org[2] - rad);
+    VectorSet(maxs, org[0] + rad, org[1] + rad, org[2] + rad);
+    G_BoxCandidates(mins, maxs, bits);
+
+    VectorCopy(org, last_org);
+    last_rad = rad;
+    last_version = grid_version;
+    return bits;
+}
+
+/*
+=============
+G_NextCandidate
+
+Returns next entity number after num that is set in candidate bitmap,
+or globals.num_edicts if there are none.
+=============
+*/
+int G_NextCandidate(const byte *bits, int num)
+{
+    for (num++; num < globals.num_edicts; num++) {
+        if (!bits[num >> 3]) {
+            num |= 7;
+            continue;
+        }
+        if (Q_IsBitSet(bits, num))
+            break;
+    }
+
+    return min(num, globals.num_edicts);
+}
+
 /*
 =================
 findradius
@@ -97,14 +502,13 @@ findradius (origin, radius)
 */
 edict_t *findradius(edict_t *from, const vec3_t org, float rad)
 {
+    const byte *bits = G_RadiusCandidates(org, rad);
+    int num = from ? from - g_edicts : -1;
     vec3_t eorg;
     vec3_t mid;
 
-    if (!from)
-        from = g_edicts;
-    else
-        from++;
-    for (; from < &g_edicts[globals.num_edicts]; from++) {
+    while ((num = G_NextCandidate(bits, num)) < globals.num_edicts) {
+        from = &g_edicts[num];
         if (!from->inuse)
             continue;
         if (from->solid == SOLID_NOT)
@@ -145,7 +549,7 @@ edict_t *G_PickTarget(const char *targetname)
     }
 
     while (1) {
-        ent = G_Find(ent, FOFS(targetname), targetname);
+        ent = G_FindByTargetname(ent, targetname);
         if (!ent)
             break;
         choice[num_choices++] = ent;
@@ -215,7 +619,7 @@ void G_UseTargets(edict_t *ent, edict_t *activator)
         // create a temp object to fire at a later time
         t = G_Spawn();
         t->classname = "DelayedUse";
-        t->nextthink = level.time + SEC(ent->delay);
+        G_SetNextThink(t, level.time + SEC(ent->delay));
         t->think = Think_Delay;
         t->activator = activator;
         if (!activator)
@@ -236,7 +640,7 @@ void G_UseTargets(edict_t *ent, edict_t *activator)
     //
     if (ent->killtarget) {
         t = NULL;
-        while ((t = G_Find(t, FOFS(targetname), ent->killtarget))) {
+        while ((t = G_FindByTargetname(t, ent->killtarget))) {
             if (t->teammaster) {
                 // PMM - if this entity is part of a chain, cleanly remove it
                 if (t->flags & FL_TEAMSLAVE) {
@@ -282,7 +686,7 @@ void G_UseTargets(edict_t *ent, edict_t *activator)
     //
     if (ent->target) {
         t = NULL;
-        while ((t = G_Find(t, FOFS(targetname), ent->target))) {
+        while ((t = G_FindByTargetname(t, ent->target))) {
             // doors fire area portals in a specific way
             if (!Q_strcasecmp(t->classname, "func_areaportal") &&
                 (!Q_strcasecmp(ent->classname, "func_door") || !Q_strcasecmp(ent->classname, "func_door_rotating") ||
@@ -291,8 +695,10 @@ void G_UseTargets(edict_t *ent, edict_t *activator)
 
             if (t == ent)
                 gi.dprintf("WARNING: Entity used itself.\n");
-            else if (t->use)
+            else if (t->use) {
+                G_WakeEntity(t);
                 t->use(t, ent, activator);
+            }
 
             if (!ent->inuse) {
                 gi.dprintf("entity was removed while using targets\n");
@@ -391,6 +797,170 @@ char *G_CopyString(const char *in, int tag)
     return out;
 }
 
+/*
+==============================================================================
+
+TRAP REGISTRY
+
+Entities flagged FL_TRAP or FL_TRAP_LASER_FIELD, so the nav code can check
+for hazards without walking all edicts. Entities register themselves when
+setting the flag; entries that are freed or no longer flagged are dropped
+during iteration.
+
+==============================================================================
+*/
+
+static int  trap_list[MAX_EDICTS];
+static int  trap_pos[MAX_EDICTS];   // list index + 1, 0 if not listed
+static int  num_traps;
+
+void G_RegisterTrap(edict_t *ent)
+{
+    int num = ent - g_edicts;
+
+    if (trap_pos[num])
+        return;
+
+    trap_list[num_traps++] = num;
+    trap_pos[num] = num_traps;
+}
+
+/*
+=============
+G_NextTrap
+
+Iterates over registered traps. Set *iter to 0 to begin; returns NULL
+when done. Order is not guaranteed.
+=============
+*/
+edict_t *G_NextTrap(int *iter)
+{
+    while (*iter < num_traps) {
+        int num = trap_list[*iter];
+        edict_t *ent = &g_edicts[num];
+
+        if (ent->inuse && (ent->flags & (FL_TRAP | FL_TRAP_LASER_FIELD))) {
+            (*iter)++;
+            return ent;
+        }
+
+        trap_pos[num] = 0;
+        if (*iter < --num_traps) {
+            trap_list[*iter] = trap_list[num_traps];
+            trap_pos[trap_list[*iter]] = *iter + 1;
+        }
+    }
+
+    return NULL;
+}
+
+static void G_InitTraps(void)
+{
+    memset(trap_pos, 0, sizeof(trap_pos));
+    num_traps = 0;
+
+    for (int i = 0; i < globals.num_edicts; i++)
+        if (g_edicts[i].inuse && (g_edicts[i].flags & (FL_TRAP | FL_TRAP_LASER_FIELD)))
+            G_RegisterTrap(&g_edicts[i]);
+}
+
+/*
+==============================================================================
+
+EDICT ALLOCATOR
+
+Free slots are kept in a FIFO ordered by freetime, so G_Spawn only has to
+look at the head of it. Entities past the client and body queue slots are
+also tracked in a dense list for quick iteration. Removal from the list
+leaves a stale entry behind that is skipped and compacted away once per
+frame, so it's safe to free entities while iterating.
+
+==============================================================================
+*/
+
+static int      free_queue[MAX_EDICTS];
+static unsigned free_head, free_tail;
+
+static int      active_list[MAX_EDICTS * 2];
+static int      active_pos[MAX_EDICTS];     // list index + 1, 0 if not listed
+static int      num_active, num_stale;
+
+void G_CompactEdictList(void)
+{
+    int i, j, num;
+
+    if (!num_stale)
+        return;
+
+    for (i = j = 0; i < num_active; i++) {
+        num = active_list[i];
+        if (active_pos[num] != i + 1)
+            continue;
+        active_list[j++] = num;
+        active_pos[num] = j;
+    }
+
+    num_active = j;
+    num_stale = 0;
+}
+
+static void G_AddActiveEdict(int num)
+{
+    if (num <= game.maxclients + BODY_QUEUE_SIZE || active_pos[num])
+        return;
+
+    if (num_active == q_countof(active_list))
+        G_CompactEdictList();
+
+    active_list[num_active++] = num;
+    active_pos[num] = num_active;
+}
+
+/*
+=============
+G_InitEdictLists
+
+Rebuilds free queue, active list, targetname index, spatial grid and trap
+registry after edicts have been wiped or loaded.
+=============
+*/
+void G_InitEdictLists(void)
+{
+    free_head = free_tail = 0;
+    num_active = num_stale = 0;
+    memset(active_pos, 0, sizeof(active_pos));
+
+    for (int i = game.maxclients + 1; i < globals.num_edicts; i++) {
+        if (g_edicts[i].inuse)
+            G_AddActiveEdict(i);
+        else
+            free_queue[free_tail++ & (q_countof(free_queue) - 1)] = i;
+    }
+
+    G_InitTargetnames();
+    G_InitGrid();
+    G_InitTraps();
+}
+
+/*
+=============
+G_NextActiveEdict
+
+Iterates over entities past the client and body queue slots. Set *iter
+to 0 to begin; returns NULL when done. Order is not guaranteed.
+=============
+*/
+edict_t *G_NextActiveEdict(int *iter)
+{
+    while (*iter < num_active) {
+        int num = active_list[(*iter)++];
+        if (active_pos[num] == *iter)
+            return &g_edicts[num];
+    }
+
+    return NULL;
+}
+
 void G_InitEdict(edict_t *e)
 {
     // ROGUE
@@ -399,7 +969,7 @@ void G_InitEdict(edict_t *e)
     //   already been released.  nextthink is being set to FRAME_TIME after level.time,
     //   since freetime = nextthink - FRAME_TIME
     if (e->nextthink)
-        e->nextthink = 0;
+        G_SetNextThink(e, 0);
     // ROGUE
 
     e->inuse = qtrue;
@@ -407,6 +977,9 @@ void G_InitEdict(edict_t *e)
     e->gravity = 1.0f;
     e->s.number = e - g_edicts;
 
+    G_WakeEntity(e);
+    G_AddActiveEdict(e->s.number);
+
     // PGM - do this before calling the spawn function so it can be overridden.
     VectorSet(e->gravityVector, 0, 0, -1);
     // PGM
@@ -425,23 +998,31 @@ angles and bad trails.
 */
 edict_t *G_Spawn(void)
 {
-    int      i;
     edict_t *e;
 
-    e = &g_edicts[game.maxclients + 1];
-    for (i = game.maxclients + 1; i < globals.num_edicts; i++, e++) {
+    while (free_head != free_tail) {
+        e = &g_edicts[free_queue[free_head & (q_countof(free_queue) - 1)]];
+        if (e->inuse) {
+            free_head++;
+            continue;
+        }
+
+        // the queue is ordered by freetime, so if the oldest slot can't
+        // be reused, neither can any other.
         // the first couple seconds of server time can involve a lot of
         // freeing and allocating, so relax the replacement policy
-        if (!e->inuse && (e->freetime < SEC(2) || level.time - e->freetime > SEC(0.5f))) {
+        if (e->freetime < SEC(2) || level.time - e->freetime > SEC(0.5f)) {
+            free_head++;
             G_InitEdict(e);
             return e;
         }
+        break;
     }
 
-    if (i == game.maxentities)
+    if (globals.num_edicts == game.maxentities)
         gi.error("ED_Alloc: no free edicts");
 
-    globals.num_edicts++;
+    e = &g_edicts[globals.num_edicts++];
     G_InitEdict(e);
     return e;
 }
@@ -460,10 +1041,13 @@ void THINK(G_FreeEdict)(edict_t *ed)
         return;
 
     gi.unlinkentity(ed); // unlink from world
+    G_UnlinkTargetname(ed);
 
     if ((ed - g_edicts) <= (game.maxclients + BODY_QUEUE_SIZE))
         return;
 
+    G_GridUnlinkEntity(ed);
+
     int id = ed->spawn_count + 1;
     memset(ed, 0, sizeof(*ed));
     ed->s.number = ed - g_edicts;
@@ -471,6 +1055,15 @@ void THINK(G_FreeEdict)(edict_t *ed)
     ed->freetime = level.time;
     ed->inuse = qfalse;
     ed->spawn_count = id;
+
+    G_CheckSleep(ed);
+
+    if (active_pos[ed->s.number]) {
+        active_pos[ed->s.number] = 0;
+        num_stale++;
+    }
+
+    free_queue[free_tail++ & (q_countof(free_queue) - 1)] = ed->s.number;
 }
 
 /*
@@ -499,6 +1092,7 @@ void G_TouchTriggers(edict_t *ent)
             continue;
         if (!hit->touch)
             continue;
+        G_WakeEntity(hit);
         hit->touch(hit, ent, &null_trace, true);
     }
 }
@@ -327,7 +327,7 @@ edict_t *fire_blaster(edict_t *self, const vec3_t start, const vec3_t dir, int d
     bolt->s.sound = gi.soundindex("misc/lasfly.wav");
     bolt->owner = self;
     bolt->touch = blaster_touch;
-    bolt->nextthink = level.time + SEC(2);
+    G_SetNextThink(bolt, level.time + SEC(2));
     bolt->think = G_FreeEdict;
     bolt->dmg = damage;
     bolt->classname = "bolt";
@@ -444,7 +444,7 @@ void THINK(Grenade4_Think)(edict_t *self)
         self->s.angles[2] = r + (FRAME_TIME_SEC * 360 * speed_frac);
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void fire_grenade(edict_t *self, const vec3_t start, const vec3_t aimdir, int damage, int speed, gtime_t timer, float damage_radius, float right_adjust, float up_adjust, bool monster)
@@ -476,18 +476,19 @@ void fire_grenade(edict_t *self, const vec3_t start, const vec3_t aimdir, int da
     grenade->solid = SOLID_BBOX;
     grenade->svflags |= SVF_PROJECTILE;
     grenade->flags |= (FL_DODGE | FL_TRAP);
+    G_RegisterTrap(grenade);
     grenade->s.effects |= EF_GRENADE;
     grenade->speed = speed;
     if (monster) {
         crandom_vec(grenade->avelocity, 360);
         grenade->s.modelindex = gi.modelindex("models/objects/grenade/tris.md2");
-        grenade->nextthink = level.time + timer;
+        G_SetNextThink(grenade, level.time + timer);
         grenade->think = Grenade_Explode;
         grenade->x.morefx |= EFX_GRENADE_LIGHT;
     } else {
         grenade->s.modelindex = gi.modelindex("models/objects/grenade4/tris.md2");
         vectoangles(grenade->velocity, grenade->s.angles);
-        grenade->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(grenade, level.time + FRAME_TIME);
         grenade->timestamp = level.time + timer;
         grenade->think = Grenade4_Think;
         grenade->s.renderfx |= RF_MINLIGHT;
@@ -530,12 +531,13 @@ void fire_grenade2(edict_t *self, const vec3_t start, const vec3_t aimdir, int d
     grenade->solid = SOLID_BBOX;
     grenade->svflags |= SVF_PROJECTILE;
     grenade->flags |= (FL_DODGE | FL_TRAP);
+    G_RegisterTrap(grenade);
     grenade->s.effects |= EF_GRENADE;
 
     grenade->s.modelindex = gi.modelindex("models/objects/grenade3/tris.md2");
     grenade->owner = self;
     grenade->touch = Grenade_Touch;
-    grenade->nextthink = level.time + timer;
+    G_SetNextThink(grenade, level.time + timer);
     grenade->think = Grenade_Explode;
     grenade->dmg = damage;
     grenade->dmg_radius = damage_radius;
@@ -619,7 +621,7 @@ edict_t *fire_rocket(edict_t *self, const vec3_t start, const vec3_t dir, int da
     rocket->s.modelindex = gi.modelindex("models/objects/rocket/tris.md2");
     rocket->owner = self;
     rocket->touch = rocket_touch;
-    rocket->nextthink = level.time + SEC(8000.0f / speed);
+    G_SetNextThink(rocket, level.time + SEC(8000.0f / speed));
     rocket->think = G_FreeEdict;
     rocket->dmg = damage;
     rocket->radius_dmg = radius_damage;
@@ -769,7 +771,7 @@ void THINK(bfg_laser_update)(edict_t *self)
     }
 
     VectorCopy(self->owner->s.origin, self->s.origin);
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     gi.linkentity(self);
 }
 
@@ -792,7 +794,7 @@ static void bfg_spawn_laser(edict_t *self)
     VectorCopy(tr.endpos, laser->s.old_origin);
     laser->s.skinnum = 0xD0D0D0D0;
     laser->think = bfg_laser_update;
-    laser->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(laser, level.time + FRAME_TIME);
     laser->timestamp = level.time + SEC(0.3f);
     laser->owner = self;
     gi.linkentity(laser);
@@ -850,7 +852,7 @@ void THINK(bfg_explode)(edict_t *self)
         }
     }
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
     self->s.frame++;
     if (self->s.frame == 5)
         self->think = G_FreeEdict;
@@ -884,7 +886,7 @@ void TOUCH(bfg_touch)(edict_t *self, edict_t *other, const trace_t *tr, bool oth
     self->s.sound = 0;
     self->s.effects &= ~EF_ANIM_ALLFAST;
     self->think = bfg_explode;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
     self->enemy = other;
 
     gi.WriteByte(svc_temp_entity);
@@ -983,7 +985,7 @@ void THINK(bfg_think)(edict_t *self)
         gi.multicast(self->s.origin, MULTICAST_PHS);
     }
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void fire_bfg(edict_t *self, const vec3_t start, const vec3_t dir, int damage, int speed, float damage_radius)
@@ -1005,7 +1007,7 @@ void fire_bfg(edict_t *self, const vec3_t start, const vec3_t dir, int damage, i
     bfg->s.modelindex = gi.modelindex("sprites/s_bfg1.sp2");
     bfg->owner = self;
     bfg->touch = bfg_touch;
-    bfg->nextthink = level.time + SEC(8000.0f / speed);
+    G_SetNextThink(bfg, level.time + SEC(8000.0f / speed));
     bfg->think = G_FreeEdict;
     bfg->radius_dmg = damage;
     bfg->dmg_radius = damage_radius;
@@ -1013,7 +1015,7 @@ void fire_bfg(edict_t *self, const vec3_t start, const vec3_t dir, int damage, i
     bfg->s.sound = gi.soundindex("weapons/bfg__l1a.wav");
 
     bfg->think = bfg_think;
-    bfg->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(bfg, level.time + FRAME_TIME);
     bfg->teammaster = bfg;
     bfg->teamchain = NULL;
 
@@ -1059,7 +1061,7 @@ void fire_disintegrator(edict_t *self, const vec3_t start, const vec3_t forward,
     bfg->s.modelindex = gi.modelindex("sprites/s_bfg1.sp2");
     bfg->owner = self;
     bfg->touch = disintegrator_touch;
-    bfg->nextthink = level.time + SEC(8000.0f / speed);
+    G_SetNextThink(bfg, level.time + SEC(8000.0f / speed));
     bfg->think = G_FreeEdict;
     bfg->classname = "disint ball";
     bfg->s.sound = gi.soundindex("weapons/bfg__l1a.wav");
@@ -446,7 +446,7 @@ static void arachnid_spawn(edict_t *self)
             return;
 
         if (ent->think) {
-            ent->nextthink = level.time;
+            G_SetNextThink(ent, level.time);
             ent->think(ent);
         }
 
@@ -526,7 +526,7 @@ static void arachnid_dead(edict_t *self)
     VectorSet(self->maxs, 16, 16, -8);
     self->movetype = MOVETYPE_TOSS;
     self->svflags |= SVF_DEADMONSTER;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     gi.linkentity(self);
 }
 
@@ -29,7 +29,7 @@ void THINK(Think_Boss3Stand)(edict_t *self)
         self->s.frame = FRAME_stand201;
     else
         self->s.frame++;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 /*QUAKED monster_boss3_stand (1 .5 0) (-32 -32 0) (32 32 90)
@@ -56,6 +56,6 @@ void SP_monster_boss3_stand(edict_t *self)
 
     self->use = Use_Boss3;
     self->think = Think_Boss3Stand;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     gi.linkentity(self);
 }
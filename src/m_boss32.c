@@ -250,7 +250,7 @@ void THINK(makron_torso_think)(edict_t *self)
     if (++self->s.frame >= 365)
         self->s.frame = 346;
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 
     if (self->s.angles[0] > 0)
         self->s.angles[0] = max(0, self->s.angles[0] - 15);
@@ -262,7 +262,7 @@ static void makron_torso(edict_t *ent)
     ent->s.modelindex = gi.modelindex("models/monsters/boss3/rider/tris.md2");
     ent->s.skinnum = 1;
     ent->think = makron_torso_think;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     ent->s.sound = gi.soundindex("makron/spine.wav");
     ent->movetype = MOVETYPE_TOSS;
     ent->s.effects = EF_GIB;
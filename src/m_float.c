@@ -579,7 +579,7 @@ static void floater_dead(edict_t *self)
     VectorSet(self->maxs, 16, 16, -8);
     self->movetype = MOVETYPE_TOSS;
     self->svflags |= SVF_DEADMONSTER;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     gi.linkentity(self);
 }
 #endif
@@ -545,7 +545,7 @@ void THINK(heat_guardian_think)(edict_t *self)
         self->speed += self->yaw_speed * FRAME_TIME_SEC;
 
     VectorScale(self->movedir, self->speed, self->velocity);
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void DIE(guardian_heat_die)(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage, const vec3_t point, mod_t mod)
@@ -582,7 +582,7 @@ static void fire_guardian_heat(edict_t *self, const vec3_t start, const vec3_t d
     heat->takedamage = true;
     heat->die = guardian_heat_die;
 
-    heat->nextthink = level.time + SEC(0.2f);
+    G_SetNextThink(heat, level.time + SEC(0.2f));
     heat->think = heat_guardian_think;
 
     heat->dmg = damage;
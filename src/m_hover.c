@@ -259,7 +259,7 @@ static void hover_gib(edict_t *self)
 void THINK(hover_deadthink)(edict_t *self)
 {
     if (!self->groundentity && level.time < self->timestamp) {
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
         return;
     }
 
@@ -488,7 +488,7 @@ static void hover_dead(edict_t *self)
     VectorSet(self->maxs, 16, 16, -8);
     self->movetype = MOVETYPE_TOSS;
     self->think = hover_deadthink;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     self->timestamp = level.time + SEC(15);
     gi.linkentity(self);
 }
@@ -294,7 +294,7 @@ bool finishHeal(edict_t *self)
         healee->monsterinfo.setskin(healee);
 
     if (healee->think) {
-        healee->nextthink = level.time;
+        G_SetNextThink(healee, level.time);
         healee->think(healee);
     }
 
@@ -1197,7 +1197,7 @@ static void medic_finish_spawn(edict_t *self)
             continue;
 
         if (ent->think) {
-            ent->nextthink = level.time;
+            G_SetNextThink(ent, level.time);
             ent->think(ent);
         }
 
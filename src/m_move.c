@@ -1169,14 +1169,22 @@ static bool M_NavPathToGoal(edict_t *self, float dist, const vec3_t goal)
             request.pathFlags |= PathFlags_LongJump;
         }
 
-        if (!Nav_GetPathToGoal(&request, &self->monsterinfo.nav_path)) {
+        if (!Nav_RequestPathToGoal(self, &request, &self->monsterinfo.nav_path)) {
+            // search still running; keep following the previous path,
+            // or let normal movement take over if there isn't one
+            if (self->monsterinfo.nav_path.returnCode != PathReturnCode_InProgress &&
+                self->monsterinfo.nav_path.returnCode != PathReturnCode_TraversalPending) {
+                self->monsterinfo.nav_path.returnCode = PathReturnCode_SearchPending;
+                return false;
+            }
+        } else if (self->monsterinfo.nav_path.returnCode >= PathReturnCode_StartPathErrors) {
             // fatal error, don't bother ever trying nodes
             if (self->monsterinfo.nav_path.returnCode == PathReturnCode_NoNavAvailable)
                 self->monsterinfo.aiflags |= AI_NO_PATH_FINDING;
             return false;
+        } else {
+            self->monsterinfo.nav_path_cache_time = level.time + SEC(2);
         }
-
-        self->monsterinfo.nav_path_cache_time = level.time + SEC(2);
     }
 
     float yaw;
@@ -1304,6 +1312,10 @@ static bool M_MoveToPath(edict_t *self, float dist)
     if (!self->inuse)
         return false;
 
+    // no path yet, don't count as blocked
+    if (self->monsterinfo.nav_path.returnCode == PathReturnCode_SearchPending)
+        return false;
+
     if (self->monsterinfo.nav_path.returnCode > PathReturnCode_StartPathErrors) {
         self->monsterinfo.path_wait_time = level.time + SEC(10);
         return false;
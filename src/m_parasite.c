@@ -396,7 +396,7 @@ void TOUCH(proboscis_touch)(edict_t *self, edict_t *other, const trace_t *tr, bo
     gi.positioned_sound(tr->endpos, self->owner, CHAN_AUTO, sound_impact, 1, ATTN_NORM, 0);
 
     VectorCopy(p, self->s.origin);
-    self->nextthink = level.time + FRAME_TIME; // start doing stuff on next frame
+    G_SetNextThink(self, level.time + FRAME_TIME); // start doing stuff on next frame
     gi.linkentity(self);
 }
 
@@ -458,7 +458,7 @@ static void parasite_get_proboscis_start(edict_t *self, vec3_t start)
 
 void THINK(proboscis_think)(edict_t *self)
 {
-    self->nextthink = level.time + FRAME_TIME; // start doing stuff on next frame
+    G_SetNextThink(self, level.time + FRAME_TIME); // start doing stuff on next frame
 
     // retracting; keep pulling until we hit the parasite
     if (self->style == 2) {
@@ -581,7 +581,7 @@ static void fire_proboscis(edict_t *self, vec3_t start, vec3_t dir, float speed)
     tip->die = proboscis_die;
     tip->touch = proboscis_touch;
     tip->think = proboscis_think;
-    tip->nextthink = level.time + FRAME_TIME; // start doing stuff on next frame
+    G_SetNextThink(tip, level.time + FRAME_TIME); // start doing stuff on next frame
     tip->svflags |= SVF_PROJECTILE;
 
     edict_t *segment = G_Spawn();
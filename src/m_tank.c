@@ -1053,7 +1053,7 @@ void THINK(Think_TankStand)(edict_t *ent)
         ent->s.frame = FRAME_stand01;
     else
         ent->s.frame++;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 /*QUAKED monster_tank_stand (1 .5 0) (-32 -32 0) (32 32 90)
@@ -1088,6 +1088,6 @@ void SP_monster_tank_stand(edict_t *self)
 
     self->use = Use_Boss3;
     self->think = Think_TankStand;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
     gi.linkentity(self);
 }
@@ -33,7 +33,7 @@ void SP_info_player_start(edict_t *self)
     // allow them to "ride" the elevators so respawning works
     if (level.is_n64 || level.is_psx || (self->spawnflags & SPAWNFLAG_SPAWN_RIDE)) {
         self->think = info_player_start_drop;
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     }
 
     if (level.is_psx)
@@ -453,7 +453,7 @@ static void TossClientWeapon(edict_t *self)
         drop->svflags &= ~SVF_INSTANCED;
 
         drop->touch = Touch_Item;
-        drop->nextthink = self->client->quad_time;
+        G_SetNextThink(drop, self->client->quad_time);
         drop->think = G_FreeEdict;
     }
 
@@ -467,7 +467,7 @@ static void TossClientWeapon(edict_t *self)
         drop->svflags &= ~SVF_INSTANCED;
 
         drop->touch = Touch_Item;
-        drop->nextthink = self->client->quadfire_time;
+        G_SetNextThink(drop, self->client->quadfire_time);
         drop->think = G_FreeEdict;
     }
     // RAFAEL
@@ -2681,8 +2681,10 @@ void ClientThink(edict_t *ent, usercmd_t *ucmd)
             if (j != i)
                 continue;   // duplicated
 
-            if (other->touch)
+            if (other->touch) {
+                G_WakeEntity(other);
                 other->touch(other, ent, &null_trace, true);
+            }
         }
     }
 
@@ -2735,9 +2737,10 @@ void ClientThink(edict_t *ent, usercmd_t *ucmd)
 
 static bool G_MonstersSearchingFor(edict_t *player)
 {
-    for (int i = game.maxclients + BODY_QUEUE_SIZE + 1; i < globals.num_edicts; i++) {
-        edict_t *ent = &g_edicts[i];
-        if (!ent->inuse || !(ent->svflags & SVF_MONSTER) || ent->health <= 0)
+    edict_t *ent;
+
+    for (int i = 0; (ent = G_NextActiveEdict(&i)); ) {
+        if (!(ent->svflags & SVF_MONSTER) || ent->health <= 0)
             continue;
 
         // check for *any* player target
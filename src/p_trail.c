@@ -67,9 +67,10 @@ static edict_t *PlayerTrail_Spawn(edict_t *owner)
 // we don't want these to stay around across level loads.
 void PlayerTrail_Destroy(edict_t *player)
 {
-    for (int i = game.maxclients + BODY_QUEUE_SIZE + 1; i < globals.num_edicts; i++) {
-        edict_t *ent = &g_edicts[i];
-        if (!ent->inuse || !ent->classname)
+    edict_t *ent;
+
+    for (int i = 0; (ent = G_NextActiveEdict(&i)); ) {
+        if (!ent->classname)
             continue;
         if (strcmp(ent->classname, "player_trail") && strcmp(ent->classname, "player_noise"))
             continue;
@@ -207,7 +207,7 @@ void SetTriggeredSpawn(edict_t *ent)
         return;
 
     ent->think = NULL;
-    ent->nextthink = 0;
+    G_SetNextThink(ent, 0);
     ent->use = Item_TriggeredSpawn;
     ent->svflags |= SVF_NOCLIENT;
     ent->solid = SOLID_NOT;
@@ -563,7 +563,7 @@ void TOUCH(hint_path_touch)(edict_t *self, edict_t *other, const trace_t *tr, bo
     // have the monster freeze if the hint path we just touched has a wait time
     // on it, for example, when riding a plat.
     if (self->wait)
-        other->nextthink = level.time + SEC(self->wait);
+        G_SetNextThink(other, level.time + SEC(self->wait));
 }
 
 /*QUAKED hint_path (.5 .3 0) (-8 -8 -8) (8 8 8) END
@@ -633,8 +633,8 @@ void InitHintPaths(void)
     for (i = 0; i < num_hint_paths; i++) {
         current = hint_path_start[i];
         current->hint_chain_id = i;
-        e = G_Find(NULL, FOFS(targetname), current->target);
-        if (G_Find(e, FOFS(targetname), current->target)) {
+        e = G_FindByTargetname(NULL, current->target);
+        if (G_FindByTargetname(e, current->target)) {
             gi.dprintf("%s: forked path detected for chain %d, target %s\n",
                        etos(current), num_hint_paths, current->target);
             hint_path_start[i]->hint_chain = NULL;
@@ -652,8 +652,8 @@ void InitHintPaths(void)
             current->hint_chain_id = i;
             if (!current->target)
                 break;
-            e = G_Find(NULL, FOFS(targetname), current->target);
-            if (G_Find(e, FOFS(targetname), current->target)) {
+            e = G_FindByTargetname(NULL, current->target);
+            if (G_FindByTargetname(e, current->target)) {
                 gi.dprintf("%s: forked path detected for chain %d, target %s\n",
                            etos(current), num_hint_paths, current->target);
                 hint_path_start[i]->hint_chain = NULL;
@@ -737,7 +737,7 @@ edict_t *SpawnBadArea(const vec3_t mins, const vec3_t maxs, gtime_t lifespan, ed
 
     if (lifespan) {
         badarea->think = G_FreeEdict;
-        badarea->nextthink = level.time + lifespan;
+        G_SetNextThink(badarea, level.time + lifespan);
     }
     if (owner)
         badarea->owner = owner;
@@ -1224,7 +1224,7 @@ void THINK(BossExplode_think)(edict_t *self)
     gi.multicast(org, MULTICAST_PVS);
 
     self->viewheight++;
-    self->nextthink = level.time + random_time_sec(0.05f, 0.2f);
+    G_SetNextThink(self, level.time + random_time_sec(0.05f, 0.2f));
 }
 
 void BossExplode(edict_t *self)
@@ -1238,6 +1238,6 @@ void BossExplode(edict_t *self)
     exploder->count = self->spawn_count;
     exploder->style = self->s.modelindex;
     exploder->think = BossExplode_think;
-    exploder->nextthink = level.time + random_time_sec(0.075f, 0.25f);
+    G_SetNextThink(exploder, level.time + random_time_sec(0.075f, 0.25f));
     exploder->viewheight = 0;
 }
@@ -188,7 +188,7 @@ void THINK(body_think)(edict_t *self)
         self->teleport_time = level.time + HZ(10);
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void fire_doppleganger(edict_t *ent, const vec3_t start, const vec3_t aimdir)
@@ -215,12 +215,13 @@ void fire_doppleganger(edict_t *ent, const vec3_t start, const vec3_t aimdir)
     base->x.alpha = 0.1f;
     base->teammaster = ent;
     base->flags |= (FL_DAMAGEABLE | FL_TRAP);
+    G_RegisterTrap(base);
     base->takedamage = true;
     base->health = 30;
     base->pain = doppleganger_pain;
     base->die = doppleganger_die;
 
-    base->nextthink = level.time + SEC(30);
+    G_SetNextThink(base, level.time + SEC(30));
     base->think = doppleganger_timeout;
 
     base->classname = "doppleganger";
@@ -239,7 +240,7 @@ void fire_doppleganger(edict_t *ent, const vec3_t start, const vec3_t aimdir)
     body->s.origin[2] += 8;
     body->teleport_time = level.time + HZ(10);
     body->think = body_think;
-    body->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(body, level.time + FRAME_TIME);
     gi.linkentity(body);
 
     base->teamchain = body;
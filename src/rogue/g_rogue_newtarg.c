@@ -87,7 +87,7 @@ void THINK(target_steam_start)(edict_t *self)
     self->use = use_target_steam;
 
     if (self->target) {
-        ent = G_Find(NULL, FOFS(targetname), self->target);
+        ent = G_FindByTargetname(NULL, self->target);
         if (!ent)
             gi.dprintf("%s: target %s not found\n", etos(self), self->target);
         self->enemy = ent;
@@ -119,7 +119,7 @@ void SP_target_steam(edict_t *self)
 
     if (self->target) {
         self->think = target_steam_start;
-        self->nextthink = level.time + SEC(1);
+        G_SetNextThink(self, level.time + SEC(1));
     } else
         target_steam_start(self);
 }
@@ -133,7 +133,7 @@ void USE(target_anger_use)(edict_t *self, edict_t *other, edict_t *activator)
     edict_t *target;
     edict_t *t;
 
-    target = G_Find(NULL, FOFS(targetname), self->killtarget);
+    target = G_FindByTargetname(NULL, self->killtarget);
 
     if (target && self->target) {
         // Make whatever a "good guy" so the monster will try to kill it!
@@ -144,7 +144,7 @@ void USE(target_anger_use)(edict_t *self, edict_t *other, edict_t *activator)
         }
 
         t = NULL;
-        while ((t = G_Find(t, FOFS(targetname), self->target))) {
+        while ((t = G_FindByTargetname(t, self->target))) {
             if (t == self) {
                 gi.dprintf("WARNING: entity used itself.\n");
             } else if (t->svflags & SVF_MONSTER) {
@@ -249,7 +249,7 @@ void THINK(blacklight_think)(edict_t *self)
     self->s.angles[0] += frandom1(10);
     self->s.angles[1] += frandom1(10);
     self->s.angles[2] += frandom1(10);
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void SP_target_blacklight(edict_t *ent)
@@ -268,7 +268,7 @@ void SP_target_blacklight(edict_t *ent)
     ent->s.modelindex = gi.modelindex("models/items/spawngro3/tris.md2");
     ent->x.scale = 6;
     ent->s.skinnum = 0;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     gi.linkentity(ent);
 }
 
@@ -288,7 +288,7 @@ void SP_target_orb(edict_t *ent)
 
     //  ent->s.effects |= EF_TRACKERTRAIL;
     ent->think = blacklight_think;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     ent->s.skinnum = 1;
     ent->s.modelindex = gi.modelindex("models/items/spawngro3/tris.md2");
     ent->s.frame = 2;
@@ -58,7 +58,7 @@ void fire_flechette(edict_t *self, const vec3_t start, const vec3_t dir, int dam
 
     flechette->owner = self;
     flechette->touch = flechette_touch;
-    flechette->nextthink = level.time + SEC(8000.0f / speed);
+    G_SetNextThink(flechette, level.time + SEC(8000.0f / speed));
     flechette->think = G_FreeEdict;
     flechette->dmg = damage;
     flechette->dmg_radius = kick;
@@ -142,7 +142,7 @@ void DIE(prox_die)(edict_t *self, edict_t *inflictor, edict_t *attacker, int dam
     } else {
         self->takedamage = false;
         self->think = Prox_Explode;
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     }
 }
 
@@ -172,7 +172,7 @@ void TOUCH(Prox_Field_Touch)(edict_t *ent, edict_t *other, const trace_t *tr, bo
     if (prox->teamchain == ent) {
         gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/proxwarn.wav"), 1, ATTN_NORM, 0);
         prox->think = Prox_Explode;
-        prox->nextthink = level.time + PROX_TIME_DELAY;
+        G_SetNextThink(prox, level.time + PROX_TIME_DELAY);
         return;
     }
 
@@ -191,7 +191,7 @@ void THINK(prox_seek)(edict_t *ent)
     if (ent->s.frame > 13)
         ent->s.frame = 9;
     ent->think = prox_seek;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 static bool monster_or_player(edict_t *ent)
@@ -264,7 +264,7 @@ void THINK(prox_open)(edict_t *ent)
         }
 
         ent->think = prox_seek;
-        ent->nextthink = level.time + SEC(0.2f);
+        G_SetNextThink(ent, level.time + SEC(0.2f));
     } else {
         if (ent->s.frame == 0) {
             gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/proxopen.wav"), 1, ATTN_NORM, 0);
@@ -272,7 +272,7 @@ void THINK(prox_open)(edict_t *ent)
         }
         ent->s.frame++;
         ent->think = prox_open;
-        ent->nextthink = level.time + HZ(10);
+        G_SetNextThink(ent, level.time + HZ(10));
     }
 }
 
@@ -348,7 +348,7 @@ void TOUCH(prox_land)(edict_t *ent, edict_t *other, const trace_t *tr, bool othe
     ent->die = prox_die;
     ent->teamchain = field;
     ent->health = PROX_HEALTH;
-    ent->nextthink = level.time;
+    G_SetNextThink(ent, level.time);
     ent->think = prox_open;
     ent->touch = NULL;
     ent->solid = SOLID_BBOX;
@@ -366,7 +366,7 @@ void THINK(Prox_Think)(edict_t *self)
 
     vectoangles(self->velocity, self->s.angles);
     self->s.angles[PITCH] -= 90;
-    self->nextthink = level.time;
+    G_SetNextThink(self, level.time);
 }
 
 void fire_prox(edict_t *self, const vec3_t start, const vec3_t aimdir, int prox_damage_multiplier, int speed)
@@ -395,6 +395,7 @@ void fire_prox(edict_t *self, const vec3_t start, const vec3_t aimdir, int prox_
     prox->svflags |= SVF_PROJECTILE;
     prox->s.effects |= EF_GRENADE;
     prox->flags |= (FL_DODGE | FL_TRAP);
+    G_RegisterTrap(prox);
     prox->clipmask = MASK_PROJECTILE | CONTENTS_LAVA | CONTENTS_SLIME;
 
     // [Paril-KEX]
@@ -411,7 +412,7 @@ void fire_prox(edict_t *self, const vec3_t start, const vec3_t aimdir, int prox_
     prox->teammaster = self;
     prox->touch = prox_land;
     prox->think = Prox_Think;
-    prox->nextthink = level.time;
+    G_SetNextThink(prox, level.time);
     prox->dmg = PROX_DAMAGE * prox_damage_multiplier;
     prox->classname = "prox_mine";
     prox->flags |= FL_DAMAGEABLE;
@@ -547,7 +548,7 @@ void THINK(Nuke_Quake)(edict_t *self)
     }
 
     if (level.time < self->timestamp)
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     else
         G_FreeEdict(self);
 }
@@ -580,7 +581,7 @@ static void Nuke_Explode(edict_t *ent)
     ent->think = Nuke_Quake;
     ent->speed = NUKE_QUAKE_STRENGTH;
     ent->timestamp = level.time + NUKE_QUAKE_TIME;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     ent->last_move_time = 0;
 }
 
@@ -640,7 +641,7 @@ void THINK(Nuke_Think)(edict_t *ent)
         }
 
         ent->think = Nuke_Think;
-        ent->nextthink = level.time + HZ(10);
+        G_SetNextThink(ent, level.time + HZ(10));
         ent->health = 1;
         ent->owner = NULL;
 
@@ -663,7 +664,7 @@ void THINK(Nuke_Think)(edict_t *ent)
             gi.sound(ent, CHAN_NO_PHS_ADD | CHAN_VOICE, gi.soundindex("weapons/nukewarn2.wav"), 1, attenuation, 0);
             ent->pain_debounce_time = level.time + SEC(1);
         }
-        ent->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(ent, level.time + FRAME_TIME);
     }
 }
 
@@ -707,7 +708,7 @@ void fire_nuke(edict_t *self, const vec3_t start, const vec3_t aimdir, int speed
     nuke->s.modelindex = gi.modelindex("models/weapons/g_nuke/tris.md2");
     nuke->owner = self;
     nuke->teammaster = self;
-    nuke->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(nuke, level.time + FRAME_TIME);
     nuke->timestamp = level.time + NUKE_DELAY + NUKE_TIME_TO_LIVE;
     nuke->think = Nuke_Think;
     nuke->touch = nuke_bounce;
@@ -853,7 +854,7 @@ void THINK(tesla_think_active)(edict_t *self)
 
     if (self->inuse) {
         self->think = tesla_think_active;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     }
 }
 
@@ -907,7 +908,7 @@ void THINK(tesla_activate)(edict_t *self)
         self->owner = NULL;
     self->teamchain = trigger;
     self->think = tesla_think_active;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     self->air_finished = level.time + TESLA_TIME_TO_LIVE;
 }
 
@@ -927,7 +928,7 @@ void THINK(tesla_think)(edict_t *ent)
     if (ent->s.frame > 14) {
         ent->s.frame = 14;
         ent->think = tesla_activate;
-        ent->nextthink = level.time + HZ(10);
+        G_SetNextThink(ent, level.time + HZ(10));
     } else {
         if (ent->s.frame > 9) {
             if (ent->s.frame == 10) {
@@ -940,7 +941,7 @@ void THINK(tesla_think)(edict_t *ent)
                 ent->s.skinnum = 3;
         }
         ent->think = tesla_think;
-        ent->nextthink = level.time + HZ(10);
+        G_SetNextThink(ent, level.time + HZ(10));
     }
 }
 
@@ -989,7 +990,7 @@ void fire_tesla(edict_t *self, const vec3_t start, const vec3_t aimdir, int tesl
     tesla->owner = self; // PGM - we don't want it owned by self YET.
     tesla->teammaster = self;
     tesla->think = tesla_think;
-    tesla->nextthink = level.time + TESLA_ACTIVATE_TIME;
+    G_SetNextThink(tesla, level.time + TESLA_ACTIVATE_TIME);
 
     // blow up on contact with lava & slime code
     tesla->touch = tesla_lava;
@@ -1005,6 +1006,7 @@ void fire_tesla(edict_t *self, const vec3_t start, const vec3_t aimdir, int tesl
     tesla->dmg = TESLA_DAMAGE * tesla_damage_multiplier;
     tesla->classname = "tesla_mine";
     tesla->flags |= (FL_DAMAGEABLE | FL_TRAP);
+    G_RegisterTrap(tesla);
     tesla->clipmask = (MASK_PROJECTILE | CONTENTS_SLIME | CONTENTS_LAVA) & ~CONTENTS_DEADMONSTER;
 
     // [Paril-KEX]
@@ -1221,7 +1223,7 @@ void fire_blaster2(edict_t *self, const vec3_t start, const vec3_t dir, int dama
     bolt->x.scale = 2.5f;
     bolt->touch = blaster2_touch;
     bolt->owner = self;
-    bolt->nextthink = level.time + SEC(2);
+    G_SetNextThink(bolt, level.time + SEC(2));
     bolt->think = G_FreeEdict;
     bolt->dmg = damage;
     bolt->classname = "bolt";
@@ -1278,7 +1280,7 @@ void THINK(tracker_pain_daemon_think)(edict_t *self)
                      pain_normal, hurt, 0, TRACKER_DAMAGE_FLAGS, (mod_t) { MOD_TRACKER });
         }
 
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
 
         if (self->enemy->client)
             self->enemy->client->tracker_pain_time = self->nextthink;
@@ -1297,7 +1299,7 @@ static void tracker_pain_daemon_spawn(edict_t *owner, edict_t *enemy, int damage
     daemon = G_Spawn();
     daemon->classname = "pain daemon";
     daemon->think = tracker_pain_daemon_think;
-    daemon->nextthink = level.time;
+    G_SetNextThink(daemon, level.time);
     daemon->timestamp = level.time + TRACKER_DAMAGE_TIME;
     daemon->owner = owner;
     daemon->enemy = enemy;
@@ -1382,7 +1384,7 @@ void THINK(tracker_fly)(edict_t *self)
     VectorScale(dir, self->speed, self->velocity);
     VectorCopy(dest, self->monsterinfo.saved_goal);
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void fire_tracker(edict_t *self, const vec3_t start, const vec3_t dir, int damage, int speed, edict_t *enemy)
@@ -1416,10 +1418,10 @@ void fire_tracker(edict_t *self, const vec3_t start, const vec3_t dir, int damag
     gi.linkentity(bolt);
 
     if (enemy) {
-        bolt->nextthink = level.time + HZ(10);
+        G_SetNextThink(bolt, level.time + HZ(10));
         bolt->think = tracker_fly;
     } else {
-        bolt->nextthink = level.time + SEC(10);
+        G_SetNextThink(bolt, level.time + SEC(10));
         bolt->think = G_FreeEdict;
     }
 
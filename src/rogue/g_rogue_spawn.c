@@ -170,7 +170,7 @@ void THINK(spawngrow_think)(edict_t *self)
     self->x.scale = Q_clipf(s, 1.0f / 16, 16);
     self->x.alpha = t * t;
 
-    self->nextthink += FRAME_TIME;
+    G_SetNextThink(self, self->nextthink + FRAME_TIME);
 }
 
 static void SpawnGro_laser_pos(edict_t *ent, vec3_t pos)
@@ -192,7 +192,7 @@ void THINK(SpawnGro_laser_think)(edict_t *self)
 {
     SpawnGro_laser_pos(self, self->s.old_origin);
     gi.linkentity(self);
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void SpawnGrow_Spawn(const vec3_t startpos, float start_size, float end_size)
@@ -228,7 +228,7 @@ void SpawnGrow_Spawn(const vec3_t startpos, float start_size, float end_size)
     ent->wait = SPAWNGROW_LIFESPAN_SEC;
     ent->timestamp = level.time + SPAWNGROW_LIFESPAN;
 
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
 
     gi.linkentity(ent);
 
@@ -243,7 +243,7 @@ void SpawnGrow_Spawn(const vec3_t startpos, float start_size, float end_size)
     beam->owner = ent;
     VectorCopy(ent->s.origin, beam->s.origin);
     beam->think = SpawnGro_laser_think;
-    beam->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(beam, level.time + FRAME_TIME);
     SpawnGro_laser_pos(beam, beam->s.old_origin);
     gi.linkentity(beam);
 }
@@ -279,7 +279,7 @@ void THINK(widowlegs_think)(edict_t *self)
 
     if (self->s.frame < MAX_LEGSFRAME) {
         self->s.frame++;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
         return;
     }
 
@@ -335,7 +335,7 @@ void THINK(widowlegs_think)(edict_t *self)
         gi.multicast(point, MULTICAST_ALL);
     }
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void Widowlegs_Spawn(const vec3_t startpos, const vec3_t angles)
@@ -353,6 +353,6 @@ void Widowlegs_Spawn(const vec3_t startpos, const vec3_t angles)
     ent->s.modelindex = gi.modelindex("models/monsters/legs/tris.md2");
     ent->think = widowlegs_think;
 
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     gi.linkentity(ent);
 }
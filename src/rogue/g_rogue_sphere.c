@@ -156,7 +156,7 @@ static void sphere_fire(edict_t *self, edict_t *enemy)
 
     self->touch = vengeance_touch;
     self->think = sphere_think_explode;
-    self->nextthink = self->timestamp;
+    G_SetNextThink(self, self->timestamp);
 }
 #endif
 
@@ -406,7 +406,7 @@ void THINK(defender_think)(edict_t *self)
     sphere_fly(self);
 
     if (self->inuse)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
 }
 
 void THINK(hunter_think)(edict_t *self)
@@ -460,7 +460,7 @@ void THINK(hunter_think)(edict_t *self)
         sphere_fly(self);
 
     if (self->inuse)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
 }
 
 void THINK(vengeance_think)(edict_t *self)
@@ -482,7 +482,7 @@ void THINK(vengeance_think)(edict_t *self)
         sphere_fly(self);
 
     if (self->inuse)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
 }
 
 // *************************
@@ -547,7 +547,7 @@ edict_t *Sphere_Spawn(edict_t *owner, spawnflags_t spawnflags)
         return NULL;
     }
 
-    sphere->nextthink = level.time + HZ(10);
+    G_SetNextThink(sphere, level.time + HZ(10));
 
     gi.linkentity(sphere);
 
@@ -22,11 +22,11 @@ edict_t *findradius2(edict_t *from, const vec3_t org, float rad)
     vec3_t eorg;
     vec3_t mid;
 
-    if (!from)
-        from = g_edicts;
-    else
-        from++;
-    for (; from < &g_edicts[globals.num_edicts]; from++) {
+    const byte *bits = G_RadiusCandidates(org, rad);
+    int num = from ? from - g_edicts : -1;
+
+    while ((num = G_NextCandidate(bits, num)) < globals.num_edicts) {
+        from = &g_edicts[num];
         if (!from->inuse)
             continue;
         if (from->solid == SOLID_NOT)
@@ -225,7 +225,7 @@ static void WidowSpawn(edict_t *self)
         ent->monsterinfo.commander = self;
         ent->monsterinfo.slots_from_commander = 1;
 
-        ent->nextthink = level.time;
+        G_SetNextThink(ent, level.time);
         ent->think(ent);
 
         ent->monsterinfo.aiflags |= AI_SPAWNED_COMMANDER | AI_DO_NOT_COUNT | AI_IGNORE_SHOTS;
@@ -897,7 +897,7 @@ static void widow_dead(edict_t *self)
     VectorSet(self->maxs, 56, 56, 80);
     self->movetype = MOVETYPE_TOSS;
     self->svflags |= SVF_DEADMONSTER;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     gi.linkentity(self);
 }
 #endif
@@ -161,7 +161,7 @@ static void Widow2Spawn(edict_t *self)
         ent->monsterinfo.commander = self;
         ent->monsterinfo.slots_from_commander = 1;
 
-        ent->nextthink = level.time;
+        G_SetNextThink(ent, level.time);
         ent->think(ent);
 
         ent->monsterinfo.aiflags |= AI_SPAWNED_COMMANDER | AI_DO_NOT_COUNT | AI_IGNORE_SHOTS;
@@ -631,7 +631,7 @@ static void widow2_finaldeath(edict_t *self)
     VectorSet(self->maxs, 70, 70, 80);
     self->movetype = MOVETYPE_TOSS;
     self->takedamage = true;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     gi.linkentity(self);
 }
 
@@ -1055,16 +1055,16 @@ static void ThrowWidowGibReal(edict_t *self, const char *gibname, int damage, gi
         gib->think = G_FreeEdict;
         // sized gibs last longer
         if (sized)
-            gib->nextthink = level.time + random_time_sec(20, 35);
+            G_SetNextThink(gib, level.time + random_time_sec(20, 35));
         else
-            gib->nextthink = level.time + random_time_sec(5, 15);
+            G_SetNextThink(gib, level.time + random_time_sec(5, 15));
     } else {
         gib->think = G_FreeEdict;
         // sized gibs last longer
         if (sized)
-            gib->nextthink = level.time + random_time_sec(60, 75);
+            G_SetNextThink(gib, level.time + random_time_sec(60, 75));
         else
-            gib->nextthink = level.time + random_time_sec(25, 35);
+            G_SetNextThink(gib, level.time + random_time_sec(25, 35));
     }
 
     if (!(type & GIB_METALLIC)) {
@@ -1218,7 +1218,7 @@ void THINK(WidowExplode)(edict_t *self)
             ThrowWidowGib(self, "models/objects/gibs/sm_metal/tris.md2", 400, GIB_METALLIC);
         self->deadflag = true;
         self->think = monster_think;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
         M_SetAnimation(self, &widow2_move_dead);
         return;
     }
@@ -1239,7 +1239,7 @@ void THINK(WidowExplode)(edict_t *self)
         gi.multicast(self->s.origin, MULTICAST_ALL);
     }
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 static void WidowExplosion1(edict_t *self)
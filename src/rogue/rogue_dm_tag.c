@@ -116,7 +116,7 @@ void THINK(Tag_Respawn)(edict_t *ent)
 
     spot = SelectDeathmatchSpawnPoint(true, false, true, NULL);
     if (spot == NULL) {
-        ent->nextthink = level.time + SEC(1);
+        G_SetNextThink(ent, level.time + SEC(1));
         return;
     }
 
@@ -132,9 +132,9 @@ void THINK(Tag_MakeTouchable)(edict_t *ent)
 
     // check here to see if it's in lava or slime. if so, do a respawn sooner
     if (gi.pointcontents(ent->s.origin) & (CONTENTS_LAVA | CONTENTS_SLIME))
-        tag_token->nextthink = level.time + SEC(3);
+        G_SetNextThink(tag_token, level.time + SEC(3));
     else
-        tag_token->nextthink = level.time + SEC(30);
+        G_SetNextThink(tag_token, level.time + SEC(30));
 }
 
 static void Tag_DropToken(edict_t *ent, const gitem_t *item)
@@ -172,7 +172,7 @@ static void Tag_DropToken(edict_t *ent, const gitem_t *item)
     tag_token->velocity[2] = 300;
 
     tag_token->think = Tag_MakeTouchable;
-    tag_token->nextthink = level.time + SEC(1);
+    G_SetNextThink(tag_token, level.time + SEC(1));
 
     gi.linkentity(tag_token);
 
@@ -19,10 +19,10 @@ void THINK(rotating_light_alarm)(edict_t *self)
 {
     if (self->spawnflags & SPAWNFLAG_ROTATING_LIGHT_START_OFF) {
         self->think = NULL;
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
     } else {
         gi.sound(self, CHAN_NO_PHS_ADD | CHAN_VOICE, self->moveinfo.sound_start, 1, ATTN_STATIC, 0);
-        self->nextthink = level.time + SEC(1);
+        G_SetNextThink(self, level.time + SEC(1));
     }
 }
 
@@ -40,7 +40,7 @@ void DIE(rotating_light_killed)(edict_t *self, edict_t *inflictor, edict_t *atta
     self->use = NULL;
 
     self->think = G_FreeEdict;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void USE(rotating_light_use)(edict_t *self, edict_t *other, edict_t *activator)
@@ -51,7 +51,7 @@ void USE(rotating_light_use)(edict_t *self, edict_t *other, edict_t *activator)
 
         if (self->spawnflags & SPAWNFLAG_ROTATING_LIGHT_ALARM) {
             self->think = rotating_light_alarm;
-            self->nextthink = level.time + FRAME_TIME;
+            G_SetNextThink(self, level.time + FRAME_TIME);
         }
     } else {
         self->spawnflags |= SPAWNFLAG_ROTATING_LIGHT_START_OFF;
@@ -106,7 +106,7 @@ The default delay is 1 second
 
 void THINK(object_repair_fx)(edict_t *ent)
 {
-    ent->nextthink = level.time + SEC(ent->delay);
+    G_SetNextThink(ent, level.time + SEC(ent->delay));
 
     if (ent->health <= 100)
         ent->health++;
@@ -124,19 +124,19 @@ void THINK(object_repair_fx)(edict_t *ent)
 void THINK(object_repair_dead)(edict_t *ent)
 {
     G_UseTargets(ent, ent);
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     ent->think = object_repair_fx;
 }
 
 void THINK(object_repair_sparks)(edict_t *ent)
 {
     if (ent->health <= 0) {
-        ent->nextthink = level.time + HZ(10);
+        G_SetNextThink(ent, level.time + HZ(10));
         ent->think = object_repair_dead;
         return;
     }
 
-    ent->nextthink = level.time + SEC(ent->delay);
+    G_SetNextThink(ent, level.time + SEC(ent->delay));
 
     gi.WriteByte(svc_temp_entity);
     gi.WriteByte(TE_WELDING_SPARKS);
@@ -155,7 +155,7 @@ void SP_object_repair(edict_t *ent)
     VectorSet(ent->mins, -8, -8, 8);
     VectorSet(ent->maxs, 8, 8, 8);
     ent->think = object_repair_sparks;
-    ent->nextthink = level.time + SEC(1);
+    G_SetNextThink(ent, level.time + SEC(1));
     ent->health = 100;
     if (!ent->delay)
         ent->delay = 1.0f;
@@ -24,7 +24,7 @@ void SP_misc_crashviper(edict_t *ent)
     VectorSet(ent->maxs, 16, 16, 32);
 
     ent->think = func_train_find;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     ent->use = misc_viper_use;
     ent->svflags |= SVF_NOCLIENT;
     ent->moveinfo.accel = ent->moveinfo.decel = ent->moveinfo.speed = ent->speed;
@@ -42,7 +42,7 @@ void USE(misc_viper_missile_use)(edict_t *self, edict_t *other, edict_t *activat
     vec3_t start, dir;
     vec3_t vec;
 
-    self->enemy = G_Find(NULL, FOFS(targetname), self->target);
+    self->enemy = G_FindByTargetname(NULL, self->target);
     if (!self->enemy) {
         gi.dprintf("%s: target %s not found\n", etos(self), self->target);
         return;
@@ -57,7 +57,7 @@ void USE(misc_viper_missile_use)(edict_t *self, edict_t *other, edict_t *activat
 
     monster_fire_rocket(self, start, dir, self->dmg, 500, MZ2_CHICK_ROCKET_1);
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
     self->think = G_FreeEdict;
 }
 
@@ -102,7 +102,7 @@ void SP_misc_transport(edict_t *ent)
     VectorSet(ent->maxs, 16, 16, 32);
 
     ent->think = func_train_find;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     ent->use = misc_strogg_ship_use;
     ent->svflags |= SVF_NOCLIENT;
     ent->moveinfo.accel = ent->moveinfo.decel = ent->moveinfo.speed = ent->speed;
@@ -119,14 +119,14 @@ Mal's amb4 loop entity
 */
 void THINK(amb4_think)(edict_t *ent)
 {
-    ent->nextthink = level.time + SEC(2.7f);
+    G_SetNextThink(ent, level.time + SEC(2.7f));
     gi.sound(ent, CHAN_VOICE, ent->noise_index, 1, ATTN_NONE, 0);
 }
 
 void SP_misc_amb4(edict_t *ent)
 {
     ent->think = amb4_think;
-    ent->nextthink = level.time + SEC(1);
+    G_SetNextThink(ent, level.time + SEC(1));
     ent->noise_index = gi.soundindex("world/amb4.wav");
     gi.linkentity(ent);
 }
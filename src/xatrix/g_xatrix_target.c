@@ -13,8 +13,9 @@ static void target_mal_laser_on(edict_t *self)
     self->spawnflags |= SPAWNFLAG_LASER_ZAP | SPAWNFLAG_LASER_ON;
     self->svflags &= ~SVF_NOCLIENT;
     self->flags |= FL_TRAP;
+    G_RegisterTrap(self);
     // target_laser_think (self);
-    self->nextthink = level.time + SEC(self->wait + self->delay);
+    G_SetNextThink(self, level.time + SEC(self->wait + self->delay));
 }
 
 void USE(target_mal_laser_use)(edict_t *self, edict_t *other, edict_t *activator)
@@ -32,7 +33,7 @@ void THINK(mal_laser_think2)(edict_t *self)
 {
     self->svflags |= SVF_NOCLIENT;
     self->think = mal_laser_think;
-    self->nextthink = level.time + SEC(self->wait);
+    G_SetNextThink(self, level.time + SEC(self->wait));
     self->spawnflags |= SPAWNFLAG_LASER_ZAP;
 }
 
@@ -41,7 +42,7 @@ void THINK(mal_laser_think)(edict_t *self)
     self->svflags &= ~SVF_NOCLIENT;
     target_laser_think(self);
     self->think = mal_laser_think2;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void SP_target_mal_laser(edict_t *self)
@@ -51,6 +52,7 @@ void SP_target_mal_laser(edict_t *self)
     self->s.renderfx |= RF_BEAM;
     self->s.modelindex = MODELINDEX_WORLD; // must be non-zero
     self->flags |= FL_TRAP_LASER_FIELD;
+    G_RegisterTrap(self);
 
     // set the beam diameter
     if (self->spawnflags & SPAWNFLAG_LASER_FAT)
@@ -84,7 +86,7 @@ void SP_target_mal_laser(edict_t *self)
     VectorSet(self->mins, -8, -8, -8);
     VectorSet(self->maxs, 8, 8, 8);
 
-    self->nextthink = level.time + SEC(self->delay);
+    G_SetNextThink(self, level.time + SEC(self->delay));
     self->think = mal_laser_think;
 
     self->use = target_mal_laser_use;
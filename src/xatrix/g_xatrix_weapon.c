@@ -24,7 +24,7 @@ void fire_blueblaster(edict_t *self, const vec3_t start, const vec3_t dir, int d
     bolt->s.sound = gi.soundindex("misc/lasfly.wav");
     bolt->owner = self;
     bolt->touch = blaster_touch;
-    bolt->nextthink = level.time + SEC(2);
+    G_SetNextThink(bolt, level.time + SEC(2));
     bolt->think = G_FreeEdict;
     bolt->dmg = damage;
     bolt->classname = "bolt";
@@ -101,7 +101,7 @@ void fire_ionripper(edict_t *self, const vec3_t start, const vec3_t dir, int dam
     ion->s.sound = gi.soundindex("misc/lasfly.wav");
     ion->owner = self;
     ion->touch = ionripper_touch;
-    ion->nextthink = level.time + SEC(3);
+    G_SetNextThink(ion, level.time + SEC(3));
     ion->think = ionripper_sparks;
     ion->dmg = damage;
     ion->dmg_radius = 100;
@@ -188,7 +188,7 @@ void THINK(heat_think)(edict_t *self)
         self->enemy = NULL;
 
     VectorScale(self->movedir, self->speed, self->velocity);
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void fire_heat(edict_t *self, const vec3_t start, const vec3_t dir, int damage, int speed, float damage_radius, int radius_damage, float turn_fraction)
@@ -212,7 +212,7 @@ void fire_heat(edict_t *self, const vec3_t start, const vec3_t dir, int damage,
     heat->speed = speed;
     heat->accel = turn_fraction;
 
-    heat->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(heat, level.time + FRAME_TIME);
     heat->think = heat_think;
 
     heat->dmg = damage;
@@ -284,7 +284,7 @@ void fire_plasma(edict_t *self, const vec3_t start, const vec3_t dir, int damage
     plasma->flags |= FL_DODGE;
     plasma->owner = self;
     plasma->touch = plasma_touch;
-    plasma->nextthink = level.time + SEC(8000.0f / speed);
+    G_SetNextThink(plasma, level.time + SEC(8000.0f / speed));
     plasma->think = G_FreeEdict;
     plasma->dmg = damage;
     plasma->radius_dmg = radius_damage;
@@ -331,7 +331,7 @@ void THINK(Trap_Gib_Think)(edict_t *ent)
     if (ent->watertype & MASK_WATER)
         ent->waterlevel = WATER_FEET;
 
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     gi.linkentity(ent);
 }
 
@@ -359,7 +359,7 @@ void THINK(Trap_Think)(edict_t *ent)
         return;
     }
 
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 
     if (!ent->groundentity)
         return;
@@ -383,7 +383,7 @@ void THINK(Trap_Think)(edict_t *ent)
         }
         ent->s.frame++;
         if (ent->s.frame == 8) {
-            ent->nextthink = level.time + SEC(1);
+            G_SetNextThink(ent, level.time + SEC(1));
             ent->think = G_FreeEdict;
             ent->s.effects &= ~EF_TRAP;
 
@@ -396,7 +396,7 @@ void THINK(Trap_Think)(edict_t *ent)
             cube->s.angles[YAW] = frandom() * 360;
             cube->velocity[2] = 400;
             cube->think(cube);
-            cube->nextthink = 0;
+            G_SetNextThink(cube, 0);
             gi.linkentity(cube);
 
             gi.sound(best, CHAN_AUTO, gi.soundindex("misc/fhit3.wav"), 1, ATTN_NORM, 0);
@@ -515,7 +515,7 @@ void THINK(Trap_Think)(edict_t *ent)
             continue;
 
         e->movetype = MOVETYPE_NONE;
-        e->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(e, level.time + FRAME_TIME);
         e->think = Trap_Gib_Think;
         e->owner = ent;
         Trap_Gib_Think(e);
@@ -552,7 +552,7 @@ void fire_trap(edict_t *self, const vec3_t start, const vec3_t aimdir, int speed
     trap->health = 20;
     trap->s.modelindex = gi.modelindex("models/weapons/z_trap/tris.md2");
     trap->owner = trap->teammaster = self;
-    trap->nextthink = level.time + SEC(1);
+    G_SetNextThink(trap, level.time + SEC(1));
     trap->think = Trap_Think;
     trap->classname = "food_cube_trap";
     // RAFAEL 16-APR-98
@@ -560,6 +560,7 @@ void fire_trap(edict_t *self, const vec3_t start, const vec3_t aimdir, int speed
     // END 16-APR-98
 
     trap->flags |= (FL_DAMAGEABLE | FL_MECHANICAL | FL_TRAP);
+    G_RegisterTrap(trap);
     trap->clipmask = MASK_PROJECTILE & ~CONTENTS_DEADMONSTER;
 
     // [Paril-KEX]
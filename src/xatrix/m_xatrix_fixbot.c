@@ -45,7 +45,7 @@ void THINK(bot_goal_check)(edict_t *self)
         return;
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 edict_t *healFindMonster(edict_t *self, float radius);
@@ -204,7 +204,7 @@ static void roam_goal(edict_t *self)
     ent->solid = SOLID_BBOX;
     ent->owner = self;
     ent->think = bot_goal_check;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     gi.linkentity(ent);
 
     oldlen = 0;
@@ -250,7 +250,7 @@ static void use_scanner(edict_t *self)
 
         // remove the old one
         if (strcmp(self->goalentity->classname, "bot_goal") == 0) {
-            self->goalentity->nextthink = level.time + FRAME_TIME;
+            G_SetNextThink(self->goalentity, level.time + FRAME_TIME);
             self->goalentity->think = G_FreeEdict;
         }
 
@@ -272,7 +272,7 @@ static void use_scanner(edict_t *self)
         if (strcmp(self->goalentity->classname, "object_repair") == 0) {
             M_SetAnimation(self, &fixbot_move_weld_start);
         } else {
-            self->goalentity->nextthink = level.time + FRAME_TIME;
+            G_SetNextThink(self->goalentity, level.time + FRAME_TIME);
             self->goalentity->think = G_FreeEdict;
             self->goalentity = self->enemy = NULL;
             M_SetAnimation(self, &fixbot_move_stand);
@@ -423,7 +423,7 @@ static void fly_vertical(edict_t *self)
     M_ChangeYaw(self);
 
     if (self->s.frame == FRAME_landing_58 || self->s.frame == FRAME_takeoff_16) {
-        self->goalentity->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self->goalentity, level.time + FRAME_TIME);
         self->goalentity->think = G_FreeEdict;
         M_SetAnimation(self, &fixbot_move_stand);
         self->goalentity = self->enemy = NULL;
@@ -453,7 +453,7 @@ static void fly_vertical2(edict_t *self)
     M_ChangeYaw(self);
 
     if (len < 32) {
-        self->goalentity->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self->goalentity, level.time + FRAME_TIME);
         self->goalentity->think = G_FreeEdict;
         M_SetAnimation(self, &fixbot_move_stand);
         self->goalentity = self->enemy = NULL;
@@ -1099,7 +1099,7 @@ static void fixbot_dead(edict_t *self)
     VectorSet(self->maxs, 16, 16, -8);
     self->movetype = MOVETYPE_TOSS;
     self->svflags |= SVF_DEADMONSTER;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     gi.linkentity(self);
 }
 #endif
@@ -652,7 +652,7 @@ static void fire_loogie(edict_t *self, const vec3_t start, const vec3_t dir, int
     loogie->s.modelindex = gi.modelindex("models/objects/loogy/tris.md2");
     loogie->owner = self;
     loogie->touch = loogie_touch;
-    loogie->nextthink = level.time + SEC(2);
+    G_SetNextThink(loogie, level.time + SEC(2));
     loogie->think = G_FreeEdict;
     loogie->dmg = damage;
     loogie->svflags |= SVF_PROJECTILE;
@@ -0,0 +1,174 @@
+// Copyright (c) ZeniMax Media Inc.
+// Licensed under the GNU General Public License 2.0.
+// bench_stubs.c -- game imports shared by offline benchmark tools
+
+#include "g_local.h"
+#include "bench_stubs.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+==============================================================================
+
+Minimal game_import_t for linking the game module into command line tools:
+tagged heap, cvars with values that can be overridden from command line,
+and messages going to stdout. Tools fill in the rest of imports they need.
+
+==============================================================================
+*/
+
+#define MAX_CVARS   64
+
+typedef struct mem_block_s {
+    struct mem_block_s  *prev, *next;
+    unsigned            tag;
+} mem_block_t;
+
+static struct {
+    cvar_t      vars[MAX_CVARS];
+    int         num_vars;
+    const char  *overrides[MAX_CVARS][2];
+    int         num_overrides;
+} cvars;
+
+static mem_block_t  mem_chain = { &mem_chain, &mem_chain };
+
+bool bench_verbose;
+
+void Bench_Print(const char *fmt, ...)
+{
+    va_list argptr;
+
+    if (!bench_verbose)
+        return;
+
+    va_start(argptr, fmt);
+    vprintf(fmt, argptr);
+    va_end(argptr);
+}
+
+q_noreturn void Bench_Error(const char *fmt, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, fmt);
+    fprintf(stderr, "ERROR: ");
+    vfprintf(stderr, fmt, argptr);
+    fprintf(stderr, "\n");
+    va_end(argptr);
+
+    exit(EXIT_FAILURE);
+}
+
+void *Bench_TagMalloc(unsigned size, unsigned tag)
+{
+    mem_block_t *b = calloc(1, sizeof(*b) + size);
+
+    if (!b)
+        Bench_Error("Out of memory");
+
+    b->tag = tag;
+    b->prev = &mem_chain;
+    b->next = mem_chain.next;
+    b->next->prev = b;
+    mem_chain.next = b;
+
+    return b + 1;
+}
+
+void Bench_TagFree(void *ptr)
+{
+    mem_block_t *b;
+
+    if (!ptr)
+        return;
+
+    b = (mem_block_t *)ptr - 1;
+    b->prev->next = b->next;
+    b->next->prev = b->prev;
+    free(b);
+}
+
+void Bench_FreeTags(unsigned tag)
+{
+    mem_block_t *b, *next;
+
+    for (b = mem_chain.next; b != &mem_chain; b = next) {
+        next = b->next;
+        if (b->tag == tag)
+            Bench_TagFree(b + 1);
+    }
+}
+
+cvar_t *Bench_Cvar(const char *name, const char *value, int flags)
+{
+    cvar_t *var;
+    int i;
+
+    for (i = 0; i < cvars.num_vars; i++)
+        if (!strcmp(cvars.vars[i].name, name))
+            return &cvars.vars[i];
+
+    if (cvars.num_vars == MAX_CVARS)
+        Bench_Error("Too many cvars");
+
+    for (i = 0; i < cvars.num_overrides; i++)
+        if (!strcmp(cvars.overrides[i][0], name))
+            value = cvars.overrides[i][1];
+
+    if (!value)
+        value = "";
+
+    var = &cvars.vars[cvars.num_vars++];
+    var->name = (char *)name;
+    var->string = (char *)value;
+    var->flags = flags;
+    var->value = atof(value);
+    var->integer = atoi(value);
+
+    return var;
+}
+
+/*
+============
+Bench_SetCvar
+
+Parses "name=value" command line argument, modifying it in place. Value
+is used instead of default when cvar is created. Returns false if argument
+is malformed or there are too many overrides.
+============
+*/
+bool Bench_SetCvar(char *arg)
+{
+    char *eq = strchr(arg, '=');
+
+    if (!eq || cvars.num_overrides == MAX_CVARS)
+        return false;
+
+    *eq = 0;
+    cvars.overrides[cvars.num_overrides][0] = arg;
+    cvars.overrides[cvars.num_overrides][1] = eq + 1;
+    cvars.num_overrides++;
+    return true;
+}
+
+// returns milliseconds
+double Bench_Time(void)
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+}
+
+void Bench_InitImports(void)
+{
+    gi.dprintf = Bench_Print;
+    gi.error = Bench_Error;
+    gi.TagMalloc = Bench_TagMalloc;
+    gi.TagFree = Bench_TagFree;
+    gi.FreeTags = Bench_FreeTags;
+    gi.cvar = Bench_Cvar;
+}
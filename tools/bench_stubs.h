@@ -0,0 +1,22 @@
+// Copyright (c) ZeniMax Media Inc.
+// Licensed under the GNU General Public License 2.0.
+// bench_stubs.h -- game imports shared by offline benchmark tools
+
+#pragma once
+
+// game messages are only printed if set
+extern bool bench_verbose;
+
+void Bench_Print(const char *fmt, ...) q_printf(1, 2);
+q_noreturn void Bench_Error(const char *fmt, ...) q_printf(1, 2);
+
+void *Bench_TagMalloc(unsigned size, unsigned tag);
+void Bench_TagFree(void *ptr);
+void Bench_FreeTags(unsigned tag);
+
+cvar_t *Bench_Cvar(const char *name, const char *value, int flags);
+bool Bench_SetCvar(char *arg);
+
+double Bench_Time(void);
+
+void Bench_InitImports(void);
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+#
+# Generates synthetic .nav file for navbench: grid of nodes connected by
+# walk links, with random walls, some ledges and conditional nodes.
+#
+
+import argparse
+import random
+import struct
+
+NAV_MAGIC = b'NAV3'
+NAV_VERSION = 6
+
+NodeFlag_CheckHasFloor = 1 << 6
+
+NavLinkType_Walk = 0
+NavLinkType_WalkOffLedge = 3
+NavLinkType_BarrierJump = 5
+
+NavLinkFlag_AllTeams = 3
+
+INVALID_ID = 0xffff
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('output')
+    parser.add_argument('--width', type=int, default=32)
+    parser.add_argument('--height', type=int, default=32)
+    parser.add_argument('--spacing', type=float, default=64)
+    parser.add_argument('--walls', type=float, default=0.15, help='fraction of removed links')
+    parser.add_argument('--ledges', type=float, default=0.02, help='fraction of raised nodes')
+    parser.add_argument('--seed', type=int, default=1)
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    w, h = args.width, args.height
+
+    def node_id(x, y):
+        return y * w + x
+
+    flags = []
+    origins = []
+    for y in range(h):
+        for x in range(w):
+            z = 32 if rng.random() < args.ledges else 0
+            flags.append(NodeFlag_CheckHasFloor if rng.random() < 0.05 else 0)
+            origins.append((x * args.spacing, y * args.spacing, z))
+
+    links = [[] for _ in range(w * h)]
+    traversals = []
+
+    for y in range(h):
+        for x in range(w):
+            for dx, dy in ((1, 0), (0, 1)):
+                nx, ny = x + dx, y + dy
+                if nx >= w or ny >= h or rng.random() < args.walls:
+                    continue
+                a, b = node_id(x, y), node_id(nx, ny)
+                for s, t in ((a, b), (b, a)):
+                    dz = origins[t][2] - origins[s][2]
+                    if dz == 0:
+                        links[s].append((t, NavLinkType_Walk, INVALID_ID))
+                        continue
+                    kind = NavLinkType_BarrierJump if dz > 0 else NavLinkType_WalkOffLedge
+                    links[s].append((t, kind, len(traversals)))
+                    traversals.append((origins[s], origins[s], origins[t], (0, 0, 0)))
+
+    num_links = sum(len(l) for l in links)
+
+    out = bytearray()
+    out += NAV_MAGIC
+    out += struct.pack('<IIIIf', NAV_VERSION, w * h, num_links, len(traversals), 1.0)
+
+    first = 0
+    for i in range(w * h):
+        out += struct.pack('<HHHH', flags[i], len(links[i]), first, 16)
+        first += len(links[i])
+
+    for o in origins:
+        out += struct.pack('<fff', *o)
+
+    for l in links:
+        for target, kind, trav in l:
+            out += struct.pack('<HBBH', target, kind, NavLinkFlag_AllTeams, trav)
+
+    for t in traversals:
+        for v in t:
+            out += struct.pack('<fff', *v)
+
+    out += struct.pack('<I', 0)
+
+    with open(args.output, 'wb') as f:
+        f.write(out)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,475 @@
+// Copyright (c) ZeniMax Media Inc.
+// Licensed under the GNU General Public License 2.0.
+// navbench.c -- offline navigation query benchmark
+
+#include "g_local.h"
+#include "g_nav.h"
+#include "bench_stubs.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+==============================================================================
+
+Runs path queries against a .nav file with the game module's navigation
+code linked against stub imports. World is either empty, so every trace
+is clear, or a list of axis aligned boxes loaded from a text file, one
+"minx miny minz maxx maxy maxz [contents]" per line.
+
+Requests are either random node pairs or loaded from a text file, one
+"startx starty startz goalx goaly goalz [pathflags [jumpheight dropheight]]"
+per line.
+
+==============================================================================
+*/
+
+typedef struct {
+    vec3_t  mins, maxs;
+    int     contents;
+} world_box_t;
+
+typedef struct {
+    vec3_t      start, goal;
+    PathFlags   path_flags;
+    float       jump_height, drop_height;
+} bench_request_t;
+
+static world_box_t  *world_boxes;
+static int          num_world_boxes;
+
+static const char   *nav_filename;
+
+static unsigned     num_traces;
+static unsigned     num_pointcontents;
+
+static csurface_t   null_surface;
+
+/*
+==============================================================================
+
+STUB IMPORTS
+
+==============================================================================
+*/
+
+static void Bench_ClientPrint(edict_t *ent, int printlevel, const char *fmt, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, fmt);
+    vprintf(fmt, argptr);
+    va_end(argptr);
+}
+
+// sweeps box through world boxes expanded by trace extents
+static trace_t q_gameabi Bench_Trace(const vec3_t start, const vec3_t mins, const vec3_t maxs,
+                                     const vec3_t end, edict_t *passent, int contentmask)
+{
+    trace_t tr = { .fraction = 1.0f, .surface = &null_surface };
+    int i, j;
+
+    num_traces++;
+
+    for (i = 0; i < num_world_boxes; i++) {
+        const world_box_t *b = &world_boxes[i];
+        float enter = -1.0f, leave = 1.0f;
+        int axis = -1;
+        bool start_out = false, end_out = false;
+
+        if (!(b->contents & contentmask))
+            continue;
+
+        for (j = 0; j < 3; j++) {
+            float lo = b->mins[j] - (maxs ? maxs[j] : 0);
+            float hi = b->maxs[j] - (mins ? mins[j] : 0);
+            float d = end[j] - start[j];
+
+            if (start[j] <= lo || start[j] >= hi)
+                start_out = true;
+            if (end[j] <= lo || end[j] >= hi)
+                end_out = true;
+
+            if (d == 0) {
+                if (start[j] <= lo || start[j] >= hi)
+                    break;
+                continue;
+            }
+
+            float t0 = (lo - start[j]) / d;
+            float t1 = (hi - start[j]) / d;
+            if (t0 > t1) {
+                float t = t0;
+                t0 = t1;
+                t1 = t;
+            }
+            if (t0 > enter) {
+                enter = t0;
+                axis = j;
+            }
+            leave = min(leave, t1);
+        }
+
+        if (j < 3)
+            continue;
+
+        if (!start_out) {
+            tr.startsolid = true;
+            tr.allsolid |= !end_out;
+            tr.fraction = 0;
+            tr.contents |= b->contents;
+            continue;
+        }
+
+        if (enter >= leave || enter < 0 || enter >= tr.fraction)
+            continue;
+
+        tr.fraction = enter;
+        tr.contents = b->contents;
+        VectorClear(tr.plane.normal);
+        tr.plane.normal[axis] = end[axis] > start[axis] ? -1 : 1;
+    }
+
+    for (j = 0; j < 3; j++)
+        tr.endpos[j] = start[j] + tr.fraction * (end[j] - start[j]);
+
+    if (tr.fraction < 1.0f)
+        tr.ent = g_edicts;
+
+    return tr;
+}
+
+static int Bench_PointContents(const vec3_t point)
+{
+    int i, contents = 0;
+
+    num_pointcontents++;
+
+    for (i = 0; i < num_world_boxes; i++) {
+        const world_box_t *b = &world_boxes[i];
+
+        if (point[0] > b->mins[0] && point[0] < b->maxs[0] &&
+            point[1] > b->mins[1] && point[1] < b->maxs[1] &&
+            point[2] > b->mins[2] && point[2] < b->maxs[2])
+            contents |= b->contents;
+    }
+
+    return contents;
+}
+
+static void *Bench_ReadFile(const char *path, long *len_p)
+{
+    FILE *f = fopen(path, "rb");
+    long len;
+    char *buf;
+
+    if (!f)
+        return NULL;
+
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    buf = malloc(len + 1);
+    if (!buf || fread(buf, 1, len, f) != len) {
+        free(buf);
+        fclose(f);
+        return NULL;
+    }
+
+    buf[len] = 0;
+    fclose(f);
+
+    *len_p = len;
+    return buf;
+}
+
+// nav code only ever asks for the .nav file and its cache
+static int Bench_LoadFile(const char *path, void **buffer, unsigned flags, unsigned tag)
+{
+    size_t n = strlen(path);
+    long len;
+    void *data;
+
+    *buffer = NULL;
+
+    if (n < 4 || strcmp(path + n - 4, ".nav"))
+        return -1;
+
+    data = Bench_ReadFile(nav_filename, &len);
+    if (!data)
+        return -1;
+
+    // terminating NUL is expected by parser
+    *buffer = Bench_TagMalloc(len + 1, tag);
+    memcpy(*buffer, data, len + 1);
+    free(data);
+
+    return len;
+}
+
+static int64_t Bench_OpenFile(const char *path, qhandle_t *f, unsigned mode)
+{
+    *f = 0;
+    return -1;
+}
+
+static filesystem_api_v1_t bench_fs = {
+    .LoadFile = Bench_LoadFile,
+    .OpenFile = Bench_OpenFile,
+};
+
+/*
+==============================================================================
+
+BENCHMARK
+
+==============================================================================
+*/
+
+static void Bench_LoadWorld(const char *path)
+{
+    long len;
+    char *data = Bench_ReadFile(path, &len);
+    char *line, *next;
+
+    if (!data)
+        Bench_Error("Couldn't read %s", path);
+
+    for (line = data; line; line = next) {
+        world_box_t b = { .contents = CONTENTS_SOLID };
+
+        next = strchr(line, '\n');
+        if (next)
+            *next++ = 0;
+
+        if (sscanf(line, "%f %f %f %f %f %f %i", &b.mins[0], &b.mins[1], &b.mins[2],
+                   &b.maxs[0], &b.maxs[1], &b.maxs[2], &b.contents) < 6)
+            continue;
+
+        world_boxes = realloc(world_boxes, sizeof(world_boxes[0]) * (num_world_boxes + 1));
+        world_boxes[num_world_boxes++] = b;
+    }
+
+    free(data);
+}
+
+static int Bench_LoadRequests(const char *path, bench_request_t **requests)
+{
+    long len;
+    char *data = Bench_ReadFile(path, &len);
+    char *line, *next;
+    int count = 0;
+
+    if (!data)
+        Bench_Error("Couldn't read %s", path);
+
+    *requests = NULL;
+
+    for (line = data; line; line = next) {
+        bench_request_t r = { .path_flags = PathFlags_Walk };
+
+        next = strchr(line, '\n');
+        if (next)
+            *next++ = 0;
+
+        if (sscanf(line, "%f %f %f %f %f %f %i %f %f", &r.start[0], &r.start[1], &r.start[2],
+                   &r.goal[0], &r.goal[1], &r.goal[2], (int *)&r.path_flags,
+                   &r.jump_height, &r.drop_height) < 6)
+            continue;
+
+        *requests = realloc(*requests, sizeof(r) * (count + 1));
+        (*requests)[count++] = r;
+    }
+
+    free(data);
+    return count;
+}
+
+// random node pairs, positions raised to roughly monster origin height
+static int Bench_RandomRequests(int count, uint32_t seed, bench_request_t **requests)
+{
+    nav_stats_t stats;
+
+    Nav_GetStats(&stats);
+    if (!stats.num_nodes)
+        return 0;
+
+    *requests = calloc(count, sizeof((*requests)[0]));
+
+    for (int i = 0; i < count; i++) {
+        bench_request_t *r = &(*requests)[i];
+
+        seed = seed * 1103515245 + 12345;
+        Nav_GetNodeOrigin((seed >> 8) % stats.num_nodes, r->start);
+        seed = seed * 1103515245 + 12345;
+        Nav_GetNodeOrigin((seed >> 8) % stats.num_nodes, r->goal);
+
+        r->start[2] += 24;
+        r->goal[2] += 24;
+        r->path_flags = PathFlags_Walk;
+    }
+
+    return count;
+}
+
+static int Bench_DoubleCmp(const void *p1, const void *p2)
+{
+    double a = *(const double *)p1;
+    double b = *(const double *)p2;
+
+    return (a > b) - (a < b);
+}
+
+static void Bench_Usage(void)
+{
+    printf("Usage: navbench [options] <file.nav>\n"
+           "  -n <count>        number of random requests (default 1000)\n"
+           "  -s <seed>         random seed (default 1)\n"
+           "  -r <file>         replay requests from file\n"
+           "  -w <file>         load box world from file (default: empty)\n"
+           "  -c <name=value>   set cvar, e.g. -c nav_clusters=1\n"
+           "  -v                print game messages\n");
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv)
+{
+    const char *request_file = NULL;
+    const char *world_file = NULL;
+    bench_request_t *requests;
+    int i, count = 1000;
+    uint32_t seed = 1;
+
+    for (i = 1; i < argc; i++) {
+        const char *a = argv[i];
+
+        if (*a != '-') {
+            nav_filename = a;
+            continue;
+        }
+
+        if (!strcmp(a, "-v")) {
+            bench_verbose = true;
+            continue;
+        }
+
+        if (i + 1 == argc)
+            Bench_Usage();
+
+        char *v = argv[++i];
+
+        if (!strcmp(a, "-n")) {
+            count = atoi(v);
+        } else if (!strcmp(a, "-s")) {
+            seed = strtoul(v, NULL, 0);
+        } else if (!strcmp(a, "-r")) {
+            request_file = v;
+        } else if (!strcmp(a, "-w")) {
+            world_file = v;
+        } else if (!strcmp(a, "-c")) {
+            if (!Bench_SetCvar(v))
+                Bench_Usage();
+        } else {
+            Bench_Usage();
+        }
+    }
+
+    if (!nav_filename || count < 1)
+        Bench_Usage();
+
+    if (world_file)
+        Bench_LoadWorld(world_file);
+
+    Bench_InitImports();
+    gi.cprintf = Bench_ClientPrint;
+    gi.trace = Bench_Trace;
+    gi.pointcontents = Bench_PointContents;
+    fs = &bench_fs;
+
+    g_edicts = Bench_TagMalloc(sizeof(g_edicts[0]) * MAX_EDICTS, TAG_GAME);
+    globals.edicts = g_edicts;
+    globals.num_edicts = 1;
+    g_edicts[0].inuse = true;
+
+    deathmatch = Bench_Cvar("deathmatch", "0", 0);
+    Bench_Cvar("nav_cache", "0", 0);
+
+    G_InitThreads();
+    Nav_Init();
+
+    // not a real map name, just used for messages
+    Nav_Load("navbench");
+
+    // entities and conditional nodes are set up on first frame after 1 sec
+    level.time = SEC(1);
+    Nav_Frame();
+
+    if (request_file)
+        count = Bench_LoadRequests(request_file, &requests);
+    else
+        count = Bench_RandomRequests(count, seed, &requests);
+
+    if (!count)
+        Bench_Error("Nothing to do (is %s a valid nav file?)", nav_filename);
+
+    double *times = calloc(count, sizeof(times[0]));
+    double total_time = 0;
+    int num_found = 0;
+    nav_stats_t before, after;
+    unsigned traces_before = num_traces;
+    unsigned contents_before = num_pointcontents;
+
+    Nav_GetStats(&before);
+
+    for (i = 0; i < count; i++) {
+        const bench_request_t *r = &requests[i];
+        PathRequest request = {
+            .moveDist = 8,
+            .pathFlags = r->path_flags,
+            .nodeSearch = {
+                .minHeight = 48,
+                .maxHeight = 64,
+                .radius = 512,
+            },
+            .traversals = {
+                .jumpHeight = r->jump_height,
+                .dropHeight = r->drop_height,
+            },
+        };
+        PathInfo info;
+
+        VectorCopy(r->start, request.start);
+        VectorCopy(r->goal, request.goal);
+
+        double start = Bench_Time();
+        if (Nav_GetPathToGoal(&request, &info))
+            num_found++;
+        times[i] = (Bench_Time() - start) * 1e3;
+        total_time += times[i];
+    }
+
+    Nav_GetStats(&after);
+
+    qsort(times, count, sizeof(times[0]), Bench_DoubleCmp);
+
+    printf("%u nodes, %d requests, %d succeeded\n", after.num_nodes, count, num_found);
+    printf("latency usec: p50 %.2f, p99 %.2f, max %.2f, mean %.2f\n",
+           times[count / 2], times[min(count * 99 / 100, count - 1)], times[count - 1], total_time / count);
+    printf("per request: %.1f nodes expanded, %.2f traces, %.2f pointcontents\n",
+           (double)(after.nodes_expanded - before.nodes_expanded) / count,
+           (double)(num_traces - traces_before) / count,
+           (double)(num_pointcontents - contents_before) / count);
+    printf("path cache: %u hits, %u misses\n",
+           after.cache_hits - before.cache_hits, after.cache_misses - before.cache_misses);
+
+    Nav_Shutdown();
+    G_ShutdownThreads();
+
+    free(times);
+    free(requests);
+    free(world_boxes);
+
+    // nothing found at all means pathfinding is broken
+    return num_found ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,677 @@
+// Copyright (c) ZeniMax Media Inc.
+// Licensed under the GNU General Public License 2.0.
+// savebench.c -- offline savegame round trip and throughput benchmark
+
+#include "g_local.h"
+#include "g_ptrs.h"
+#include "bench_stubs.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if USE_ZLIB
+#include <zlib.h>
+#endif
+
+/*
+==============================================================================
+
+Synthesizes random worlds of given sizes with the game module's savegame
+code linked against stub imports, then saves and loads them in text, binary
+and delta formats, reporting file sizes and time per operation.
+
+Every load is verified by saving the loaded state in binary format again
+and comparing with binary savegame of the original state. Binary format
+stores every non-default field of every table bit for bit, so this checks
+all save_field_t entries without duplicating the field tables here. Text
+format writes floats with %.6g, so random floats are generated with at most
+6 significant digits to make text round trips exact too.
+
+Delta format saves against a baseline taken when the world was generated,
+after which some entities are modified, removed and added. Like the server
+does, the world is spawned again before each delta load.
+
+==============================================================================
+*/
+
+#define BENCH_CLIENTS   4
+
+#define SAVE_GAME   "savebench.ssv"
+#define SAVE_LEVEL  "savebench.sav"
+#define REF_GAME    "savebench_ref.ssv"
+#define REF_LEVEL   "savebench_ref.sav"
+#define CHK_GAME    "savebench_chk.ssv"
+#define CHK_LEVEL   "savebench_chk.sav"
+
+typedef enum {
+    FMT_TEXT,
+    FMT_BINARY,
+    FMT_DELTA,
+
+    FMT_TOTAL
+} bench_format_t;
+
+static const char *const format_names[FMT_TOTAL] = { "text", "binary", "delta" };
+
+typedef struct {
+    char    *data;
+    long    len;
+} bench_file_t;
+
+static uint32_t     bench_seed;
+
+static const char *const bench_strings[] = {
+    "t1", "t2", "door1", "lift", "monster_soldier", "func_door", "info_notnull",
+    "path_corner", "misc_explobox", "trigger_multiple", "The \"quoted\" one",
+    "multi\nline\ttext", "back\\slash", "\x7f\x80\xff high bits",
+};
+
+/*
+==============================================================================
+
+STUB IMPORTS
+
+==============================================================================
+*/
+
+static void Bench_LinkEntity(edict_t *ent)
+{
+}
+
+static int Bench_Index(const char *name)
+{
+    return 0;
+}
+
+/*
+==============================================================================
+
+WORLD GENERATION
+
+==============================================================================
+*/
+
+static uint32_t Bench_Rand(void)
+{
+    bench_seed = bench_seed * 1103515245 + 12345;
+    return bench_seed >> 8;
+}
+
+static int Bench_RandInt(int n)
+{
+    return Bench_Rand() % n;
+}
+
+static uint64_t Bench_Rand64(void)
+{
+    return (uint64_t)Bench_Rand() << 40 ^ (uint64_t)Bench_Rand() << 20 ^ Bench_Rand();
+}
+
+// at most 6 significant digits, survives %.6g
+static float Bench_RandFloat(void)
+{
+    return (Bench_RandInt(80000) - 40000) * 0.25f;
+}
+
+static void Bench_RandVector(vec3_t v)
+{
+    v[0] = Bench_RandFloat();
+    v[1] = Bench_RandFloat();
+    v[2] = Bench_RandFloat();
+}
+
+static char *Bench_RandString(void)
+{
+    return G_CopyString(bench_strings[Bench_RandInt(q_countof(bench_strings))], TAG_LEVEL);
+}
+
+// NULL half of the time
+static char *Bench_MaybeString(void)
+{
+    return Bench_RandInt(2) ? Bench_RandString() : NULL;
+}
+
+static edict_t *Bench_MaybeEdict(void)
+{
+    return Bench_RandInt(2) ? &g_edicts[Bench_RandInt(globals.num_edicts)] : NULL;
+}
+
+static const gitem_t *Bench_RandItem(void)
+{
+    const gitem_t *item;
+
+    do {
+        item = &itemlist[1 + Bench_RandInt(IT_TOTAL - 1)];
+    } while (!item->classname);
+
+    return item;
+}
+
+static const void *Bench_RandPointer(ptr_type_t type)
+{
+    return save_ptrs[type][Bench_RandInt(num_save_ptrs[type])].ptr;
+}
+
+#define SET_POINTER(field, type) \
+    (*(const void **)&(field) = Bench_RandPointer(type))
+
+static void Bench_RandMoveinfo(moveinfo_t *m)
+{
+    Bench_RandVector(m->start_origin);
+    Bench_RandVector(m->start_angles);
+    Bench_RandVector(m->end_origin);
+    Bench_RandVector(m->end_angles);
+    m->sound_start = Bench_RandInt(256);
+    m->sound_end = Bench_RandInt(256);
+    m->accel = Bench_RandFloat();
+    m->speed = Bench_RandFloat();
+    m->decel = Bench_RandFloat();
+    m->distance = Bench_RandFloat();
+    m->wait = Bench_RandFloat();
+    m->state = Bench_RandInt(4);
+    m->reversing = Bench_RandInt(2);
+    Bench_RandVector(m->dir);
+    m->current_speed = Bench_RandFloat();
+    m->remaining_distance = Bench_RandFloat();
+    SET_POINTER(m->endfunc, P_moveinfo_endfunc);
+}
+
+static void Bench_RandMonsterinfo(monsterinfo_t *m)
+{
+    SET_POINTER(m->active_move, P_mmove_t);
+    m->aiflags = Bench_Rand64();
+    m->nextframe = Bench_RandInt(400);
+    m->scale = Bench_RandFloat();
+    SET_POINTER(m->stand, P_monsterinfo_stand);
+    SET_POINTER(m->walk, P_monsterinfo_walk);
+    SET_POINTER(m->run, P_monsterinfo_run);
+    SET_POINTER(m->attack, P_monsterinfo_attack);
+    SET_POINTER(m->sight, P_monsterinfo_sight);
+    m->pausetime = Bench_Rand64();
+    m->attack_finished = Bench_RandInt(100000);
+    Bench_RandVector(m->saved_goal);
+    Bench_RandVector(m->last_sighting);
+    m->attack_state = Bench_RandInt(8);
+    m->lefty = Bench_RandInt(2);
+    m->idle_time = Bench_RandInt(100000);
+    m->power_armor_type = Bench_RandInt(3);
+    m->power_armor_power = Bench_RandInt(500);
+    m->goal_hint = Bench_MaybeEdict();
+    m->base_height = Bench_RandFloat();
+
+    if (!Bench_RandInt(8)) {
+        reinforcement_list_t *list = &m->reinforcements;
+
+        list->num_reinforcements = 1 + Bench_RandInt(4);
+        list->reinforcements = gi.TagMalloc(sizeof(list->reinforcements[0]) * list->num_reinforcements, TAG_LEVEL);
+        for (int i = 0; i < list->num_reinforcements; i++) {
+            reinforcement_t *r = &list->reinforcements[i];
+            r->classname = Bench_RandString();
+            r->strength = Bench_RandInt(10);
+            r->radius = Bench_RandFloat();
+            Bench_RandVector(r->mins);
+            Bench_RandVector(r->maxs);
+        }
+    }
+}
+
+static void Bench_RandEntity(edict_t *e)
+{
+    e->inuse = true;
+    e->classname = Bench_RandString();
+    e->s.number = e - g_edicts;
+
+    Bench_RandVector(e->s.origin);
+    Bench_RandVector(e->s.angles);
+    e->s.modelindex = Bench_RandInt(256);
+    e->s.frame = Bench_RandInt(200);
+    e->s.skinnum = Bench_RandInt(4);
+    e->s.effects = Bench_Rand();
+    e->s.renderfx = Bench_Rand();
+    Bench_RandVector(e->mins);
+    Bench_RandVector(e->maxs);
+    e->solid = Bench_RandInt(4);
+    e->svflags = Bench_RandInt(2) ? SVF_MONSTER : 0;
+    e->owner = Bench_MaybeEdict();
+
+    e->movetype = Bench_RandInt(MOVETYPE_WALLBOUNCE);
+    e->flags = Bench_Rand64();
+    e->spawnflags = Bench_Rand();
+    e->target = Bench_MaybeString();
+    e->targetname = Bench_MaybeString();
+    e->message = Bench_MaybeString();
+    e->team = Bench_MaybeString();
+    e->speed = Bench_RandFloat();
+    e->wait = Bench_RandFloat();
+    e->delay = Bench_RandFloat();
+    Bench_RandVector(e->velocity);
+    e->mass = Bench_RandInt(1000);
+    e->gravity = Bench_RandInt(4) ? 1.0f : 0.5f;
+    e->health = Bench_RandInt(1000) - 100;
+    e->max_health = Bench_RandInt(1000);
+    e->dmg = Bench_RandInt(100);
+    e->count = Bench_RandInt(10);
+    e->style = Bench_RandInt(32);
+    e->enemy = Bench_MaybeEdict();
+    e->goalentity = Bench_MaybeEdict();
+    e->item = Bench_RandInt(4) ? NULL : Bench_RandItem();
+
+    e->nextthink = Bench_RandInt(100000);
+    SET_POINTER(e->think, P_think);
+    if (Bench_RandInt(2))
+        SET_POINTER(e->touch, P_touch);
+    if (Bench_RandInt(2))
+        SET_POINTER(e->use, P_use);
+
+    if (Bench_RandInt(2))
+        Bench_RandMoveinfo(&e->moveinfo);
+
+    if (e->svflags & SVF_MONSTER) {
+        SET_POINTER(e->pain, P_pain);
+        SET_POINTER(e->die, P_die);
+        Bench_RandMonsterinfo(&e->monsterinfo);
+    }
+}
+
+static void Bench_RandClient(gclient_t *cl)
+{
+    client_persistent_t *pers = &cl->pers;
+    int i;
+
+    for (i = 0; i < 3; i++) {
+        cl->ps.pmove.origin[i] = Bench_Rand() - (1 << 23);
+        cl->ps.pmove.velocity[i] = Bench_RandInt(8000) - 4000;
+    }
+    cl->ps.pmove.pm_flags = Bench_RandInt(256);
+    Bench_RandVector(cl->ps.viewangles);
+    Bench_RandVector(cl->ps.viewoffset);
+    cl->ps.gunindex = Bench_RandInt(256);
+    cl->ps.gunframe = Bench_RandInt(100);
+    cl->ps.fov = 90;
+    cl->ps.stats[STAT_SELECTED_ITEM_NAME] = Bench_RandInt(256);
+
+    Q_snprintf(pers->netname, sizeof(pers->netname), "player%u", Bench_Rand());
+    Q_snprintf(pers->userinfo, sizeof(pers->userinfo), "\\name\\%s\\hand\\2", pers->netname);
+    pers->health = Bench_RandInt(200);
+    pers->max_health = 100;
+    for (i = 0; i < IT_TOTAL; i++)
+        if (!Bench_RandInt(4) && itemlist[i].classname)
+            pers->inventory[i] = Bench_RandInt(300);
+    for (i = AMMO_BULLETS; i < AMMO_MAX; i++)
+        pers->max_ammo[i] = Bench_RandInt(500);
+    pers->weapon = Bench_RandItem();
+    pers->lastweapon = Bench_RandItem();
+    pers->score = Bench_RandInt(100);
+    pers->lives = Bench_RandInt(3);
+
+    cl->resp.coop_respawn = *pers;
+    cl->resp.entertime = Bench_RandInt(100000);
+    cl->resp.score = Bench_RandInt(100);
+    cl->killer_yaw = Bench_RandFloat();
+    Bench_RandVector(cl->kick.angles);
+    cl->v_dmg_roll = Bench_RandFloat();
+}
+
+static void Bench_RandLevel(int num_entities)
+{
+    int i;
+
+    memset(&level, 0, sizeof(level));
+    memset(g_edicts, 0, game.maxentities * sizeof(g_edicts[0]));
+
+    level.time = Bench_RandInt(1000000);
+    Q_strlcpy(level.level_name, "Bench \"level\"", sizeof(level.level_name));
+    Q_strlcpy(level.mapname, "savebench", sizeof(level.mapname));
+    level.total_monsters = Bench_RandInt(100);
+    level.killed_monsters = Bench_RandInt(100);
+    level.total_secrets = Bench_RandInt(10);
+
+    globals.num_edicts = game.maxclients + 1 + num_entities;
+
+    g_edicts[0].inuse = true;
+    g_edicts[0].classname = G_CopyString("worldspawn", TAG_LEVEL);
+
+    for (i = 0; i < game.maxclients; i++) {
+        edict_t *e = &g_edicts[i + 1];
+
+        e->inuse = true;
+        e->classname = G_CopyString("player", TAG_LEVEL);
+        e->client = &game.clients[i];
+        e->s.number = i + 1;
+        Bench_RandVector(e->s.origin);
+        e->health = Bench_RandInt(100);
+        e->gravity = 1.0f;
+    }
+
+    for (i = game.maxclients + 1; i < globals.num_edicts; i++)
+        Bench_RandEntity(&g_edicts[i]);
+}
+
+static void Bench_RandGame(void)
+{
+    game.autosaved = false;
+    Q_strlcpy(game.helpmessage1, "Find the \"exit\"", sizeof(game.helpmessage1));
+    game.cross_level_flags = Bench_Rand();
+
+    for (int i = 0; i < 4; i++) {
+        level_entry_t *entry = &game.level_entries[i];
+        Q_snprintf(entry->map_name, sizeof(entry->map_name), "base%d", i + 1);
+        entry->total_monsters = Bench_RandInt(100);
+        entry->time = Bench_RandInt(1000000);
+        entry->visit_order = i + 1;
+    }
+
+    memset(game.clients, 0, game.maxclients * sizeof(game.clients[0]));
+    for (int i = 0; i < game.maxclients; i++)
+        Bench_RandClient(&game.clients[i]);
+}
+
+// same as SpawnEntities, world is generated from the same seed each time
+static void Bench_SpawnLevel(uint32_t seed, int num_entities)
+{
+    gi.FreeTags(TAG_LEVEL);
+
+    G_BeginBaseline(level.mapname);
+    bench_seed = seed;
+    Bench_RandLevel(num_entities);
+    G_EndBaseline();
+}
+
+// changes made since spawn for delta savegames
+static void Bench_ChangeLevel(void)
+{
+    int i, first = game.maxclients + 1;
+
+    for (i = first; i < globals.num_edicts; i++) {
+        edict_t *e = &g_edicts[i];
+
+        switch (Bench_RandInt(20)) {
+        case 0:
+            e->health -= Bench_RandInt(100);
+            e->s.origin[2] += 8;
+            e->target = NULL;
+            e->moveinfo.speed = 0;
+            break;
+        case 1:
+            e->monsterinfo.aiflags ^= 1;
+            e->enemy = &g_edicts[1];
+            break;
+        case 2:
+            memset(e, 0, sizeof(*e));
+            break;
+        }
+    }
+
+    for (i = 0; i < 16 && globals.num_edicts < game.maxentities; i++)
+        Bench_RandEntity(&g_edicts[globals.num_edicts++]);
+}
+
+/*
+==============================================================================
+
+BENCHMARK
+
+==============================================================================
+*/
+
+static long Bench_FileSize(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    long len;
+
+    if (!f)
+        Bench_Error("Couldn't open %s", path);
+
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    fclose(f);
+
+    return len;
+}
+
+// reads decompressed savegame
+static bench_file_t Bench_ReadSave(const char *path)
+{
+    bench_file_t file = { 0 };
+    long size = 0;
+    int ret;
+
+#if USE_ZLIB
+    gzFile f = gzopen(path, "rb");
+#else
+    FILE *f = fopen(path, "rb");
+#endif
+    if (!f)
+        Bench_Error("Couldn't open %s", path);
+
+    do {
+        if (file.len == size) {
+            size = size ? size * 2 : 0x10000;
+            file.data = realloc(file.data, size);
+            if (!file.data)
+                Bench_Error("Out of memory");
+        }
+#if USE_ZLIB
+        ret = gzread(f, file.data + file.len, size - file.len);
+#else
+        ret = fread(file.data + file.len, 1, size - file.len, f);
+#endif
+        if (ret < 0)
+            Bench_Error("Couldn't read %s", path);
+        file.len += ret;
+    } while (ret);
+
+#if USE_ZLIB
+    gzclose(f);
+#else
+    fclose(f);
+#endif
+
+    return file;
+}
+
+// saves current state in binary format
+static void Bench_WriteBinary(const char *game_name, const char *level_name)
+{
+    int binary_saves = g_binary_saves->integer;
+    int delta_saves = g_delta_saves->integer;
+
+    g_binary_saves->integer = 1;
+    g_delta_saves->integer = 0;
+    WriteGame(game_name, false);
+    WriteLevel(level_name);
+    g_binary_saves->integer = binary_saves;
+    g_delta_saves->integer = delta_saves;
+}
+
+static bool Bench_CompareFiles(const char *a, const char *b, const char *what)
+{
+    bench_file_t fa = Bench_ReadSave(a);
+    bench_file_t fb = Bench_ReadSave(b);
+    long i, len = min(fa.len, fb.len);
+
+    for (i = 0; i < len; i++)
+        if (fa.data[i] != fb.data[i])
+            break;
+
+    free(fa.data);
+    free(fb.data);
+
+    if (i == len && fa.len == fb.len)
+        return true;
+
+    printf("%s round trip mismatch at offset %ld\n", what, i);
+    return false;
+}
+
+// returns false if round trip of any format failed
+static bool Bench_Run(int num_entities, uint32_t seed, int iterations)
+{
+    bool ok = true;
+
+    for (int fmt = 0; fmt < FMT_TOTAL; fmt++) {
+        double write_game = 0, read_game = 0, write_level = 0, read_level = 0, start;
+        bench_file_t raw;
+        long size;
+        bool game_ok, level_ok;
+
+        g_binary_saves->integer = fmt != FMT_TEXT;
+        g_delta_saves->integer = fmt == FMT_DELTA;
+
+        bench_seed = seed;
+        Bench_RandGame();
+        Bench_SpawnLevel(seed, num_entities);
+        if (fmt == FMT_DELTA)
+            Bench_ChangeLevel();
+        Bench_WriteBinary(REF_GAME, REF_LEVEL);
+
+        for (int i = 0; i < iterations; i++) {
+            start = Bench_Time();
+            WriteGame(SAVE_GAME, false);
+            write_game += Bench_Time() - start;
+
+            start = Bench_Time();
+            WriteLevel(SAVE_LEVEL);
+            write_level += Bench_Time() - start;
+
+            start = Bench_Time();
+            ReadGame(SAVE_GAME);
+            read_game += Bench_Time() - start;
+
+            // server spawns the level again before loading it
+            if (fmt == FMT_DELTA)
+                Bench_SpawnLevel(seed, num_entities);
+
+            start = Bench_Time();
+            ReadLevel(SAVE_LEVEL);
+            read_level += Bench_Time() - start;
+        }
+
+        // WriteLevel may still be running with g_async_saves
+        G_CleanupSaves();
+
+        size = Bench_FileSize(SAVE_LEVEL);
+        raw = Bench_ReadSave(SAVE_LEVEL);
+        free(raw.data);
+
+        // loaded state must save exactly as the original one
+        Bench_WriteBinary(CHK_GAME, CHK_LEVEL);
+        G_CleanupSaves();
+        game_ok = Bench_CompareFiles(REF_GAME, CHK_GAME, "game");
+        level_ok = Bench_CompareFiles(REF_LEVEL, CHK_LEVEL, "level");
+
+        printf("%6d  %-6s  %9.1f %9.1f  %8.3f %8.3f  %8.3f %8.3f  %s\n",
+               num_entities, format_names[fmt], size / 1024.0, raw.len / 1024.0,
+               write_level / iterations, read_level / iterations,
+               write_game / iterations, read_game / iterations,
+               game_ok && level_ok ? "ok" : "FAILED");
+
+        ok &= game_ok && level_ok;
+    }
+
+    return ok;
+}
+
+static void Bench_Usage(void)
+{
+    printf("Usage: savebench [options]\n"
+           "  -n <count>        iterations per format (default 10)\n"
+           "  -s <seed>         random seed (default 1)\n"
+           "  -e <count>        number of entities (default: 100, 1000 and 8000)\n"
+           "  -c <name=value>   set cvar, e.g. -c g_async_saves=1\n"
+           "  -v                print game messages\n");
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv)
+{
+    static const int default_sizes[] = { 100, 1000, 8000 };
+    const int *sizes = default_sizes;
+    int num_sizes = q_countof(default_sizes);
+    int i, iterations = 10, num_entities = 0;
+    uint32_t seed = 1;
+    bool ok = true;
+
+    for (i = 1; i < argc; i++) {
+        const char *a = argv[i];
+
+        if (!strcmp(a, "-v")) {
+            bench_verbose = true;
+            continue;
+        }
+
+        if (*a != '-' || i + 1 == argc)
+            Bench_Usage();
+
+        char *v = argv[++i];
+
+        if (!strcmp(a, "-n")) {
+            iterations = atoi(v);
+        } else if (!strcmp(a, "-s")) {
+            seed = strtoul(v, NULL, 0);
+        } else if (!strcmp(a, "-e")) {
+            num_entities = atoi(v);
+        } else if (!strcmp(a, "-c")) {
+            if (!Bench_SetCvar(v))
+                Bench_Usage();
+        } else {
+            Bench_Usage();
+        }
+    }
+
+    if (iterations < 1)
+        Bench_Usage();
+
+    Bench_InitImports();
+    gi.linkentity = Bench_LinkEntity;
+    gi.modelindex = Bench_Index;
+    gi.soundindex = Bench_Index;
+    gi.imageindex = Bench_Index;
+
+    game.maxclients = BENCH_CLIENTS;
+    game.maxentities = MAX_EDICTS;
+    g_edicts = Bench_TagMalloc(sizeof(g_edicts[0]) * game.maxentities, TAG_GAME);
+    game.clients = Bench_TagMalloc(sizeof(game.clients[0]) * game.maxclients, TAG_GAME);
+    globals.edicts = g_edicts;
+    globals.max_edicts = game.maxentities;
+
+    if (num_entities) {
+        sizes = &num_entities;
+        num_sizes = 1;
+    }
+
+    for (i = 0; i < num_sizes; i++)
+        if (sizes[i] < 1 || sizes[i] > game.maxentities - game.maxclients - 1 - 16)
+            Bench_Error("Bad number of entities: %d", sizes[i]);
+
+    skill = Bench_Cvar("skill", "1", 0);
+    deathmatch = Bench_Cvar("deathmatch", "0", 0);
+    coop = Bench_Cvar("coop", "1", 0);
+    g_strict_saves = Bench_Cvar("g_strict_saves", "1", 0);
+    g_binary_saves = Bench_Cvar("g_binary_saves", "0", 0);
+    g_async_saves = Bench_Cvar("g_async_saves", "0", 0);
+    g_delta_saves = Bench_Cvar("g_delta_saves", "0", 0);
+
+    G_InitThreads();
+    InitItems();
+    G_InitSaveFields();
+
+    printf("%d iterations, seed %u, sizes in KiB, times in ms\n", iterations, seed);
+    printf("%6s  %-6s  %9s %9s  %8s %8s  %8s %8s  %s\n", "ents", "format",
+           "level", "raw", "wr level", "rd level", "wr game", "rd game", "round trip");
+
+    for (i = 0; i < num_sizes; i++)
+        ok &= Bench_Run(sizes[i], seed, iterations);
+
+    G_CleanupSaves();
+    G_ShutdownThreads();
+
+    remove(SAVE_GAME);
+    remove(SAVE_LEVEL);
+    remove(REF_GAME);
+    remove(REF_LEVEL);
+    remove(CHK_GAME);
+    remove(CHK_LEVEL);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}